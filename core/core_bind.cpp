@@ -595,7 +595,21 @@ uint64_t OS::get_static_memory_peak_usage() const {
 }
 
 Dictionary OS::get_memory_info() const {
-	return ::OS::get_singleton()->get_memory_info();
+	Dictionary info = ::OS::get_singleton()->get_memory_info();
+#ifdef SMALL_ALLOCATOR_ENABLED
+	Array size_classes;
+	for (uint32_t i = 0; i < Memory::get_size_class_count(); i++) {
+		const Memory::SizeClassStats stats = Memory::get_size_class_stats(i);
+		Dictionary size_class;
+		size_class["size"] = stats.size;
+		size_class["reserved_blocks"] = stats.reserved_blocks;
+		size_class["allocations"] = stats.allocations;
+		size_class["frees"] = stats.frees;
+		size_classes.push_back(size_class);
+	}
+	info["size_classes"] = size_classes;
+#endif
+	return info;
 }
 
 /** This method uses a signed argument for better error reporting as it's used from the scripting API. */
@@ -185,6 +185,7 @@ public:
 	Variant get_var(bool p_allow_objects = false) const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
+	virtual const uint8_t *map_read_only() { return nullptr; } ///< map the whole file into memory for reading, valid until the file is closed; nullptr if not supported
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
 	virtual String get_line() const;
 	virtual String get_token() const;
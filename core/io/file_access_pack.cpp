@@ -30,8 +30,11 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/compression.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/version.h"
 
@@ -45,7 +48,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_compressed) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -54,6 +57,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
 	pf.bundle = p_bundle;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -63,6 +67,11 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	pf.src = p_src;
 
 	if (!exists || p_replace_files) {
+		// Count the new entry first, so replacing a file with one from the same pack doesn't release it.
+		pack_file_counts[pf.pack]++;
+		if (exists) {
+			_release_pack_file(files[pmd5]);
+		}
 		files[pmd5] = pf;
 	}
 
@@ -117,9 +126,21 @@ void PackedData::remove_path(const String &p_path) {
 
 	cd->files.erase(simplified_path.get_file());
 
+	_release_pack_file(files[pmd5]);
 	files.erase(pmd5);
 }
 
+void PackedData::_release_pack_file(const PackedFile &p_file) {
+	HashMap<String, uint32_t>::Iterator E = pack_file_counts.find(p_file.pack);
+	ERR_FAIL_COND(!E);
+	if (--E->value == 0) {
+		pack_file_counts.remove(E);
+		if (p_file.src) {
+			p_file.src->release_pack(p_file.pack);
+		}
+	}
+}
+
 void PackedData::add_pack_source(PackSource *p_source) {
 	if (p_source != nullptr) {
 		sources.push_back(p_source);
@@ -154,6 +175,9 @@ void PackedData::_get_file_paths(PackedDir *p_dir, const String &p_parent_dir, H
 }
 
 void PackedData::clear() {
+	for (const KeyValue<PathMD5, PackedFile> &E : files) {
+		_release_pack_file(E.value);
+	}
 	files.clear();
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
@@ -263,21 +287,21 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
-	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3.
+	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3 and V4.
 	bool sparse_bundle = (pack_flags & PACK_SPARSE_BUNDLE);
 
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version >= PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
 
-	if (version == PACK_FORMAT_VERSION_V3) {
-		// V3: Read directory offset and skip reserved part of the header.
+	if (version >= PACK_FORMAT_VERSION_V3) {
+		// V3 and V4: Read directory offset and skip reserved part of the header.
 		uint64_t dir_offset = f->get_64() + pck_start_pos;
 		f->seek(dir_offset);
 	} else if (version == PACK_FORMAT_VERSION_V2) {
@@ -318,18 +342,53 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		uint8_t md5[16];
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
+		ERR_FAIL_COND_V_MSG((flags & PACK_FILE_COMPRESSED) && version < PACK_FORMAT_VERSION_V4, false, vformat("Pack version %d can't contain compressed files: \"%s\".", version, path));
 
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle);
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_COMPRESSED));
 		}
 	}
 
+	if (!sparse_bundle && PackedData::get_singleton()->has_pack_files(p_path)) {
+		_map_pack(p_path);
+	}
+
 	return true;
 }
 
+void PackedSourcePCK::_map_pack(const String &p_path) {
+	// The pack may have been overwritten since it was mapped, the new directory only matches the current file.
+	mapped_packs.erase(p_path);
+
+	// Not all platforms (or packs inside other packs) support it, in which case files are read through regular file handles.
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+	if (file.is_null()) {
+		return;
+	}
+	const uint8_t *data = file->map_read_only();
+	if (!data) {
+		return;
+	}
+
+	MappedPack &mapped = mapped_packs[p_path];
+	mapped.file = file;
+	mapped.data = data;
+	mapped.size = file->get_length();
+}
+
+void PackedSourcePCK::release_pack(const String &p_path) {
+	mapped_packs.erase(p_path);
+}
+
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	if (!p_file->encrypted && !p_file->bundle) {
+		const MappedPack *mapped = mapped_packs.getptr(p_file->pack);
+		if (mapped && p_file->offset + p_file->size <= mapped->size) {
+			return memnew(FileAccessPack(*p_file, mapped->file, mapped->data + p_file->offset));
+		}
+	}
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
@@ -379,7 +438,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped_data) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -395,7 +456,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped_data && !compressed) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -429,12 +492,20 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	const uint64_t read_pos = pos;
 	pos += to_read;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (compressed) {
+		ERR_FAIL_COND_V_MSG(!_get_compressed_buffer(p_dst, read_pos, to_read), -1, vformat("Can't decompress pack-referenced file from '%s'.", String(pf.pack)));
+	} else if (mapped_data) {
+		memcpy(p_dst, mapped_data + read_pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
@@ -443,7 +514,9 @@ void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (!mapped_data && !compressed) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -467,6 +540,134 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped_data = nullptr;
+	block_cache.clear();
+	cached_block = -1;
+	read_buffer.clear();
+}
+
+uint64_t FileAccessPack::_get_block_size(uint32_t p_block) const {
+	return MIN(pf.size - uint64_t(p_block) * block_size, (uint64_t)block_size);
+}
+
+// Returns the requested part of the file as stored in the pack, which is only valid until the next call.
+const uint8_t *FileAccessPack::_read_stored(uint64_t p_offset, uint64_t p_size) const {
+	if (mapped_data) {
+		return mapped_data + p_offset;
+	}
+
+	read_buffer.resize(p_size);
+	f->seek(off + p_offset);
+	if (f->get_buffer(read_buffer.ptr(), p_size) != p_size) {
+		return nullptr;
+	}
+	return read_buffer.ptr();
+}
+
+bool FileAccessPack::_open_compressed() {
+	// The compressed data is never larger than the file, which also keeps reads within the pack mapping.
+	ERR_FAIL_COND_V(pf.size < 8, false);
+	const uint8_t *header = _read_stored(0, 8);
+	ERR_FAIL_NULL_V(header, false);
+	block_size = decode_uint32(header);
+	const uint32_t block_count = decode_uint32(header + 4);
+	ERR_FAIL_COND_V(block_size == 0 || block_count != (pf.size + block_size - 1) / block_size, false);
+
+	const uint64_t table_size = uint64_t(block_count) * 4;
+	ERR_FAIL_COND_V(8 + table_size > pf.size, false);
+	const uint8_t *table = _read_stored(8, table_size);
+	ERR_FAIL_NULL_V(table, false);
+
+	block_offsets.resize(block_count + 1);
+	block_offsets[0] = 8 + table_size;
+	for (uint32_t i = 0; i < block_count; i++) {
+		block_offsets[i + 1] = block_offsets[i] + decode_uint32(table + i * 4);
+	}
+	ERR_FAIL_COND_V(block_offsets[block_count] > pf.size, false);
+
+	compressed = true;
+	return true;
+}
+
+void FileAccessPack::_decompress_block_task(void *p_userdata, uint32_t p_index) {
+	DecompressBlocks *job = (DecompressBlocks *)p_userdata;
+	const FileAccessPack *file = job->file;
+	const uint32_t block = job->first_block + p_index;
+
+	const uint64_t src_ofs = file->block_offsets[block] - file->block_offsets[job->first_block];
+	const int64_t src_size = file->block_offsets[block + 1] - file->block_offsets[block];
+	const int64_t dst_size = file->_get_block_size(block);
+	if (Compression::decompress(job->dst + uint64_t(p_index) * file->block_size, dst_size, job->src + src_ofs, src_size, Compression::MODE_ZSTD) != dst_size) {
+		job->failed.set();
+	}
+}
+
+bool FileAccessPack::_decompress_blocks(uint32_t p_first, uint32_t p_count, uint8_t *p_dst) const {
+	DecompressBlocks job;
+	job.file = this;
+	job.first_block = p_first;
+	job.src = _read_stored(block_offsets[p_first], block_offsets[p_first + p_count] - block_offsets[p_first]);
+	job.dst = p_dst;
+	ERR_FAIL_NULL_V(job.src, false);
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool && p_count >= MIN_BLOCKS_PER_DECOMPRESS_GROUP) {
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(&_decompress_block_task, &job, p_count, -1, true, SNAME("DecompressPackedFile"));
+		pool->wait_for_group_task_completion(group);
+	} else {
+		for (uint32_t i = 0; i < p_count; i++) {
+			_decompress_block_task(&job, i);
+		}
+	}
+
+	return !job.failed.is_set();
+}
+
+bool FileAccessPack::_load_block(uint32_t p_block) const {
+	if (cached_block == p_block) {
+		return true;
+	}
+
+	cached_block = -1;
+	block_cache.resize(block_size);
+	if (!_decompress_blocks(p_block, 1, block_cache.ptr())) {
+		return false;
+	}
+	cached_block = p_block;
+	return true;
+}
+
+bool FileAccessPack::_get_compressed_buffer(uint8_t *p_dst, uint64_t p_pos, uint64_t p_length) const {
+	const uint32_t block_count = block_offsets.size() - 1;
+	const uint64_t end = p_pos + p_length;
+
+	while (p_pos < end) {
+		const uint32_t block = p_pos / block_size;
+		const uint64_t block_start = uint64_t(block) * block_size;
+		const uint64_t block_end = block_start + _get_block_size(block);
+
+		if (p_pos == block_start && end >= block_end && cached_block != block) {
+			// Blocks read whole are decompressed straight into the destination.
+			const uint32_t run_end = end >= pf.size ? block_count : uint32_t(end / block_size);
+			if (!_decompress_blocks(block, run_end - block, p_dst)) {
+				return false;
+			}
+			const uint64_t run_size = MIN(uint64_t(run_end) * block_size, pf.size) - block_start;
+			p_dst += run_size;
+			p_pos += run_size;
+			continue;
+		}
+
+		if (!_load_block(block)) {
+			return false;
+		}
+		const uint64_t count = MIN(end, block_end) - p_pos;
+		memcpy(p_dst, block_cache.ptr() + (p_pos - block_start), count);
+		p_dst += count;
+		p_pos += count;
+	}
+
+	return true;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) {
@@ -501,6 +702,26 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 	}
 	pos = 0;
 	eof = false;
+
+	if (pf.compressed && !_open_compressed()) {
+		f = Ref<FileAccess>();
+		ERR_FAIL_MSG(vformat("Can't open compressed pack-referenced file '%s'.", String(pf.pack)));
+	}
+}
+
+FileAccessPack::FileAccessPack(const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack, const uint8_t *p_mapped_data) {
+	pf = p_file;
+	f = p_mapped_pack;
+	mapped_data = p_mapped_data;
+	off = pf.offset;
+	pos = 0;
+	eof = false;
+
+	if (pf.compressed && !_open_compressed()) {
+		f = Ref<FileAccess>();
+		mapped_data = nullptr;
+		ERR_FAIL_MSG(vformat("Can't open compressed pack-referenced file '%s'.", String(pf.pack)));
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////////////
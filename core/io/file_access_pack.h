@@ -35,14 +35,17 @@
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
+#define PACK_FORMAT_VERSION_V4 4 // Same layout as V3, files can be compressed.
 
-// The current packed file format version number.
+// The packed file format version number written by default.
+// V4 is only written when the pack actually holds compressed files, so other packs stay readable by older runtimes.
 #define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V3
 
 enum PackFlags {
@@ -54,8 +57,12 @@ enum PackFlags {
 enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
+	PACK_FILE_COMPRESSED = 1 << 2,
 };
 
+// Uncompressed size of the blocks PCKPacker splits compressed files into. Each file stores its own, so it can change.
+#define PACK_COMPRESSED_BLOCK_SIZE (64 * 1024)
+
 class PackSource;
 
 class PackedData {
@@ -72,6 +79,7 @@ public:
 		PackSource *src = nullptr;
 		bool encrypted;
 		bool bundle;
+		bool compressed = false;
 	};
 
 private:
@@ -103,6 +111,7 @@ private:
 	};
 
 	HashMap<PathMD5, PackedFile, PathMD5> files;
+	HashMap<String, uint32_t> pack_file_counts; // Entries of `files` from each pack, so packs nothing refers to anymore are released.
 
 	Vector<PackSource *> sources;
 
@@ -112,12 +121,14 @@ private:
 	bool disabled = false;
 
 	void _free_packed_dirs(PackedDir *p_dir);
+	void _release_pack_file(const PackedFile &p_file);
 	void _get_file_paths(PackedDir *p_dir, const String &p_parent_dir, HashSet<String> &r_paths) const;
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_compressed = false); // for PackSource
 	void remove_path(const String &p_path);
+	bool has_pack_files(const String &p_pkg_path) const { return pack_file_counts.has(p_pkg_path); } // for PackSource
 	uint8_t *get_file_hash(const String &p_path);
 	HashSet<String> get_file_paths() const;
 
@@ -145,13 +156,28 @@ class PackSource {
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) = 0;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) = 0;
+	virtual void release_pack(const String &p_path) {} // No file in the resource filesystem comes from the pack anymore.
 	virtual ~PackSource() {}
 };
 
 class PackedSourcePCK : public PackSource {
+	// Packs mapped into memory, so reading their unencrypted files needs no file handle of their own.
+	// A mapping is dropped once no file in the resource filesystem comes from its pack anymore (all of them were
+	// replaced or removed, or PackedData was cleared), and replaced when the pack is opened again. Files already
+	// opened from it keep the mapping alive until they are closed, after which the pack file can be overwritten.
+	struct MappedPack {
+		Ref<FileAccess> file; // Owns the mapping.
+		const uint8_t *data = nullptr;
+		uint64_t size = 0;
+	};
+	HashMap<String, MappedPack> mapped_packs;
+
+	void _map_pack(const String &p_path);
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+	virtual void release_pack(const String &p_path) override;
 };
 
 class PackedSourceDirectory : public PackSource {
@@ -171,6 +197,36 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	const uint8_t *mapped_data = nullptr; // Start of this file in the pack mapping, if reading from it; `f` then only keeps the mapping alive.
+
+	// Compressed files are stored as a table of block sizes followed by independently compressed Zstandard blocks,
+	// so seeking only needs to decompress the block it lands in, and large reads can decompress blocks in parallel.
+	bool compressed = false;
+	uint32_t block_size = 0;
+	LocalVector<uint64_t> block_offsets; // From the start of the stored file, with the end of the last block appended.
+	mutable LocalVector<uint8_t> block_cache;
+	mutable int64_t cached_block = -1;
+	mutable LocalVector<uint8_t> read_buffer;
+
+	// Below this, decompressing a read on the calling thread is faster than handing it to the WorkerThreadPool.
+	static const uint32_t MIN_BLOCKS_PER_DECOMPRESS_GROUP = 4;
+
+	struct DecompressBlocks {
+		const FileAccessPack *file = nullptr;
+		uint32_t first_block = 0;
+		const uint8_t *src = nullptr;
+		uint8_t *dst = nullptr;
+		SafeFlag failed;
+	};
+
+	static void _decompress_block_task(void *p_userdata, uint32_t p_index);
+	uint64_t _get_block_size(uint32_t p_block) const;
+	const uint8_t *_read_stored(uint64_t p_offset, uint64_t p_size) const;
+	bool _open_compressed();
+	bool _decompress_blocks(uint32_t p_first, uint32_t p_count, uint8_t *p_dst) const;
+	bool _load_block(uint32_t p_block) const;
+	bool _get_compressed_buffer(uint8_t *p_dst, uint64_t p_pos, uint64_t p_length) const;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -208,6 +264,7 @@ public:
 	virtual void close() override;
 
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack, const uint8_t *p_mapped_data);
 };
 
 int64_t PackedData::get_size(const String &p_path) {
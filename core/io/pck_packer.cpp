@@ -31,9 +31,11 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/compression.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/marshalls.h"
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -46,10 +48,40 @@ static int _get_pad(int p_alignment, int p_n) {
 	return pad;
 }
 
+// Splits the data into independently compressed blocks (see FileAccessPack), returns false if that doesn't make it smaller.
+static bool _compress_blocks(const Vector<uint8_t> &p_data, Vector<uint8_t> &r_compressed) {
+	const uint64_t data_size = p_data.size();
+	const uint32_t block_count = (data_size + PACK_COMPRESSED_BLOCK_SIZE - 1) / PACK_COMPRESSED_BLOCK_SIZE;
+
+	r_compressed.resize(8 + block_count * 4);
+	encode_uint32(PACK_COMPRESSED_BLOCK_SIZE, r_compressed.ptrw());
+	encode_uint32(block_count, r_compressed.ptrw() + 4);
+
+	Vector<uint8_t> block;
+	block.resize(Compression::get_max_compressed_buffer_size(PACK_COMPRESSED_BLOCK_SIZE, Compression::MODE_ZSTD));
+
+	for (uint32_t i = 0; i < block_count; i++) {
+		const uint64_t block_ofs = uint64_t(i) * PACK_COMPRESSED_BLOCK_SIZE;
+		const int64_t block_size = MIN(data_size - block_ofs, (uint64_t)PACK_COMPRESSED_BLOCK_SIZE);
+		const int64_t compressed_size = Compression::compress(block.ptrw(), p_data.ptr() + block_ofs, block_size, Compression::MODE_ZSTD);
+		ERR_FAIL_COND_V(compressed_size < 0, false);
+
+		encode_uint32(compressed_size, r_compressed.ptrw() + 8 + i * 4);
+		const int64_t write_ofs = r_compressed.size();
+		r_compressed.resize(write_ofs + compressed_size);
+		memcpy(r_compressed.ptrw() + write_ofs, block.ptr(), compressed_size);
+	}
+
+	// Readers rely on the compressed data never being larger than the file itself.
+	return (uint64_t)r_compressed.size() < data_size;
+}
+
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
+	ClassDB::bind_method(D_METHOD("set_compress_files", "enabled"), &PCKPacker::set_compress_files);
+	ClassDB::bind_method(D_METHOD("is_compressing_files"), &PCKPacker::is_compressing_files);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
 
@@ -90,7 +122,8 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	version_ofs = file->get_position();
+	file->store_32(PACK_FORMAT_VERSION); // Updated in flush() if any file ends up compressed.
 	file->store_32(GODOT_VERSION_MAJOR);
 	file->store_32(GODOT_VERSION_MINOR);
 	file->store_32(GODOT_VERSION_PATCH);
@@ -172,6 +205,11 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	}
 	pf.encrypted = p_encrypt;
 
+	Vector<uint8_t> compressed_data;
+	if (compress_files && !data.is_empty()) {
+		pf.compressed = _compress_blocks(data, compressed_data);
+	}
+
 	Ref<FileAccess> ftmp = file;
 
 	Ref<FileAccessEncrypted> fae;
@@ -184,7 +222,7 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 		ftmp = fae;
 	}
 
-	ftmp->store_buffer(data);
+	ftmp->store_buffer(pf.compressed ? compressed_data : data);
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -201,6 +239,14 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	return OK;
 }
 
+void PCKPacker::set_compress_files(bool p_enabled) {
+	compress_files = p_enabled;
+}
+
+bool PCKPacker::is_compressing_files() const {
+	return compress_files;
+}
+
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
@@ -213,6 +259,14 @@ Error PCKPacker::flush(bool p_verbose) {
 	uint64_t dir_offset = file->get_position();
 	file->seek(dir_base_ofs);
 	file->store_64(dir_offset);
+
+	for (const File &pf : files) {
+		if (pf.compressed) {
+			file->seek(version_ofs);
+			file->store_32(PACK_FORMAT_VERSION_V4);
+			break;
+		}
+	}
 	file->seek(dir_offset);
 
 	file->store_32(uint32_t(files.size()));
@@ -253,6 +307,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 
 		if (p_verbose) {
@@ -35,6 +35,7 @@
 #include "core/io/file_access_compressed.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 #include "scene/property_utils.h"
 #include "scene/resources/packed_scene.h"
@@ -408,7 +409,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					}
 
 					//always use internal cache for loading internal resources
-					if (!internal_index_cache.has(path)) {
+					// Resources stored after the one being parsed don't count, even if already created. This is what breaks reference cycles.
+					const uint32_t *position = internal_index_positions.getptr(path);
+					if (!internal_index_cache.has(path) || (position && *position > parsing_position)) {
 						WARN_PRINT(vformat("Couldn't load resource (no cache): %s.", path));
 						r_v = Variant();
 					} else {
@@ -707,6 +710,13 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	// Internal resources are loaded in three steps: first all of them are created, then their properties are parsed
+	// (spread across worker threads when sub-threads are allowed), and finally the properties are set in file order.
+	// When the parsing is not spread, each resource is parsed right before its properties are set instead, so only
+	// one resource's decoded properties are held at a time.
+	LocalVector<InternalResourceLoad> loads;
+	loads.resize(internal_resources.size());
+
 	for (int i = 0; i < internal_resources.size(); i++) {
 		bool main = i == (internal_resources.size() - 1);
 
@@ -731,6 +741,7 @@ Error ResourceLoaderBinary::load() {
 					//already loaded, don't do anything
 					error = OK;
 					internal_index_cache[path] = cached;
+					internal_index_positions[path] = i;
 					continue;
 				}
 			}
@@ -807,31 +818,49 @@ Error ResourceLoaderBinary::load() {
 
 		if (!main) {
 			internal_index_cache[path] = res;
+			internal_index_positions[path] = i;
 		}
 
-		int pc = f->get_32();
-
-		//set properties
-
-		Dictionary missing_resource_properties;
+		InternalResourceLoad &load = loads[i];
+		load.position = i;
+		load.resource = res;
+		load.missing_resource = missing_resource;
+		load.property_count = f->get_32();
+		load.properties_offset = f->get_position();
+	}
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	bool properties_parsed = false;
+	error = _parse_internal_resource_properties(loads, properties_parsed);
+	if (error) {
+		return error;
+	}
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+	for (uint32_t i = 0; i < loads.size(); i++) {
+		InternalResourceLoad &load = loads[i];
+		if (load.resource.is_null()) {
+			continue; // Reused from the cache.
+		}
 
-			Variant value;
+		bool main = i == (loads.size() - 1);
+		Ref<Resource> &res = load.resource;
 
-			error = parse_variant(value);
+		if (!properties_parsed) {
+			error = _parse_resource_properties(load);
 			if (error) {
 				return error;
 			}
+		}
+
+		//set properties
+
+		Dictionary missing_resource_properties;
+
+		for (Pair<StringName, Variant> &E : load.properties) {
+			const StringName &name = E.first;
+			Variant &value = E.second;
 
 			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+			if (value.get_type() == Variant::OBJECT && load.missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
 				// If the property being set is a missing resource (and the parent is not),
 				// then setting it will most likely not work.
 				// Instead, save it as metadata.
@@ -872,9 +901,10 @@ Error ResourceLoaderBinary::load() {
 				res->set(name, value);
 			}
 		}
+		load.properties.clear(); // Don't keep a second reference to the data around.
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		if (load.missing_resource) {
+			load.missing_resource->set_recording_properties(false);
 		}
 
 		if (!missing_resource_properties.is_empty()) {
@@ -886,7 +916,7 @@ Error ResourceLoaderBinary::load() {
 #endif
 
 		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+			*progress = (i + 1) / float(loads.size());
 		}
 
 		resource_cache.push_back(res);
@@ -903,6 +933,141 @@ Error ResourceLoaderBinary::load() {
 	return ERR_FILE_EOF;
 }
 
+Error ResourceLoaderBinary::_parse_resource_properties(InternalResourceLoad &r_load) {
+	f->seek(r_load.properties_offset);
+	r_load.properties.resize(r_load.property_count);
+	parsing_position = r_load.position;
+
+	for (uint32_t i = 0; i < r_load.property_count; i++) {
+		StringName name = _get_string();
+
+		if (name == StringName()) {
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
+
+		r_load.properties[i].first = name;
+		Error err = parse_variant(r_load.properties[i].second);
+		if (err) {
+			return err;
+		}
+	}
+
+	return OK;
+}
+
+void ResourceLoaderBinary::_parse_properties_task(PropertyParseTask *p_task) {
+	// Every task parses on its own copy of the loader state, reading from its own handle to the file.
+	ResourceLoaderBinary sub_loader;
+	sub_loader.local_path = local_path;
+	sub_loader.res_path = res_path;
+	sub_loader.ver_format = ver_format;
+	sub_loader.string_map = string_map;
+	sub_loader.using_named_scene_ids = using_named_scene_ids;
+	sub_loader.using_uids = using_uids;
+	sub_loader.external_resources = external_resources;
+	sub_loader.internal_resources = internal_resources;
+	sub_loader.internal_index_cache = internal_index_cache;
+	sub_loader.internal_index_positions = internal_index_positions;
+	sub_loader.remaps = remaps;
+	sub_loader.cache_mode = cache_mode;
+	sub_loader.cache_mode_for_external = cache_mode_for_external;
+
+	Error err = OK;
+	sub_loader.f = _open_file_for_parsing(&err);
+	if (err != OK) {
+		p_task->error = err;
+		return;
+	}
+
+	while (true) {
+		uint32_t index = p_task->next_index->postincrement();
+		if (index >= p_task->pending->size()) {
+			break;
+		}
+		err = sub_loader._parse_resource_properties((*p_task->loads)[(*p_task->pending)[index]]);
+		if (err != OK) {
+			p_task->error = err;
+			return;
+		}
+	}
+}
+
+Ref<FileAccess> ResourceLoaderBinary::_open_file_for_parsing(Error *r_error) const {
+	Ref<FileAccess> file = FileAccess::open(file_path, FileAccess::READ, r_error);
+	ERR_FAIL_COND_V_MSG(file.is_null(), Ref<FileAccess>(), vformat("Cannot open file '%s'.", file_path));
+
+	uint8_t header[4];
+	file->get_buffer(header, 4);
+	if (header[0] == 'R' && header[1] == 'S' && header[2] == 'C' && header[3] == 'C') {
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		*r_error = fac->open_after_magic(file);
+		ERR_FAIL_COND_V(*r_error != OK, Ref<FileAccess>());
+		file = fac;
+	}
+
+	file->set_big_endian(f->is_big_endian());
+	file->real_is_double = f->real_is_double;
+	return file;
+}
+
+Error ResourceLoaderBinary::_parse_internal_resource_properties(LocalVector<InternalResourceLoad> &r_loads, bool &r_parsed) {
+	r_parsed = false;
+
+	LocalVector<uint32_t> pending;
+	for (uint32_t i = 0; i < r_loads.size(); i++) {
+		if (r_loads[i].resource.is_valid()) {
+			pending.push_back(i);
+		}
+	}
+
+	uint32_t task_count = 0;
+	if (use_sub_threads && !file_path.is_empty()) {
+		task_count = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), pending.size() / MIN_RESOURCES_PER_PARSE_TASK);
+	}
+
+	if (task_count < 2) {
+		// Not worth spreading, let the caller parse each resource as it sets it.
+		return OK;
+	}
+
+	// Wait for the external resources here, so the tasks below find them finished instead of racing to wait on them.
+	// Errors are reported when the references to them are parsed.
+	for (const ExtResource &er : external_resources) {
+		if (er.load_token.is_valid()) {
+			Error err;
+			ResourceLoader::_load_complete(*er.load_token.ptr(), &err);
+		}
+	}
+
+	// Resources are handed out one at a time, since their sizes vary wildly (e.g., a mesh versus a material).
+	// The calling thread takes part too, with its own file handle.
+	SafeNumeric<uint32_t> next_index;
+	LocalVector<PropertyParseTask> parse_tasks;
+	parse_tasks.resize(task_count);
+	LocalVector<WorkerThreadPool::TaskID> task_ids;
+	for (PropertyParseTask &parse_task : parse_tasks) {
+		parse_task.loads = &r_loads;
+		parse_task.pending = &pending;
+		parse_task.next_index = &next_index;
+	}
+	for (uint32_t i = 1; i < task_count; i++) {
+		task_ids.push_back(WorkerThreadPool::get_singleton()->add_template_task(this, &ResourceLoaderBinary::_parse_properties_task, &parse_tasks[i], true, SNAME("ResourceLoaderBinaryParseProperties")));
+	}
+	_parse_properties_task(&parse_tasks[0]);
+	for (WorkerThreadPool::TaskID task_id : task_ids) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
+
+	for (const PropertyParseTask &parse_task : parse_tasks) {
+		if (parse_task.error != OK) {
+			return parse_task.error;
+		}
+	}
+	r_parsed = true;
+	return OK;
+}
+
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
 	translation_remapped = p_remapped;
 }
@@ -1241,6 +1406,7 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	String path = !p_original_path.is_empty() ? p_original_path : p_path;
 	loader.local_path = ProjectSettings::get_singleton()->localize_path(path);
 	loader.res_path = loader.local_path;
+	loader.file_path = p_path;
 	loader.open(f);
 
 	err = loader.load();
@@ -33,8 +33,12 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
 #include "core/templates/rb_map.h"
 
+class MissingResource;
+
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
 	String local_path;
@@ -93,6 +97,36 @@ class ResourceLoaderBinary {
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
+	String file_path; // File actually opened, so worker threads can open their own handles to it.
+
+	// Position in the file of each internal resource, since references only resolve to resources stored before.
+	HashMap<String, uint32_t> internal_index_positions;
+	uint32_t parsing_position = UINT32_MAX;
+
+	struct InternalResourceLoad {
+		uint32_t position = 0;
+		Ref<Resource> resource; // Null if reused from the cache.
+		MissingResource *missing_resource = nullptr;
+		uint64_t properties_offset = 0;
+		uint32_t property_count = 0;
+		LocalVector<Pair<StringName, Variant>> properties;
+	};
+
+	struct PropertyParseTask {
+		LocalVector<InternalResourceLoad> *loads = nullptr;
+		const LocalVector<uint32_t> *pending = nullptr;
+		SafeNumeric<uint32_t> *next_index = nullptr;
+		Error error = OK;
+	};
+
+	// Below this, spreading the parsing across threads isn't worth opening extra file handles.
+	static const uint32_t MIN_RESOURCES_PER_PARSE_TASK = 8;
+
+	Error _parse_resource_properties(InternalResourceLoad &r_load);
+	Error _parse_internal_resource_properties(LocalVector<InternalResourceLoad> &r_loads, bool &r_parsed);
+	void _parse_properties_task(PropertyParseTask *p_task);
+	Ref<FileAccess> _open_file_for_parsing(Error *r_error) const;
+
 public:
 	Ref<Resource> get_resource();
 	Error load();
@@ -33,6 +33,44 @@
 
 #include "core/variant/typed_array.h"
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+static _FORCE_INLINE_ uint32_t lowest_bit_index(uint64_t p_bits) {
+#if defined(__GNUC__)
+	return __builtin_ctzll(p_bits);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long index;
+	_BitScanForward64(&index, p_bits);
+	return index;
+#else
+	uint32_t index = 0;
+	while (!(p_bits & 1)) {
+		p_bits >>= 1;
+		index++;
+	}
+	return index;
+#endif
+}
+
+static _FORCE_INLINE_ uint32_t highest_bit_index(uint64_t p_bits) {
+#if defined(__GNUC__)
+	return 63 - __builtin_clzll(p_bits);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long index;
+	_BitScanReverse64(&index, p_bits);
+	return index;
+#else
+	uint32_t index = 63;
+	while (!(p_bits >> 63)) {
+		p_bits <<= 1;
+		index--;
+	}
+	return index;
+#endif
+}
+
 static real_t heuristic_euclidean(const Vector2i &p_from, const Vector2i &p_to) {
 	real_t dx = (real_t)Math::abs(p_to.x - p_from.x);
 	real_t dy = (real_t)Math::abs(p_to.y - p_from.y);
@@ -132,13 +170,22 @@ void AStarGrid2D::update() {
 	const int32_t end_x = region.get_end().x;
 	const int32_t end_y = region.get_end().y;
 	const Vector2 half_cell_size = cell_size / 2;
-	for (int32_t x = region.position.x; x < end_x + 2; x++) {
-		solid_mask.push_back(true);
+
+	// All cells start out walkable, only the border around the region is solid.
+	const size_t mask_width = region.size.x + 2;
+	const size_t mask_height = region.size.y + 2;
+	solid_mask.resize_initialized((mask_width * mask_height + 63) / 64);
+	for (size_t x = 0; x < mask_width; x++) {
+		_set_solid_bit(x, true);
+		_set_solid_bit((mask_height - 1) * mask_width + x, true);
+	}
+	for (size_t y = 1; y < mask_height - 1; y++) {
+		_set_solid_bit(y * mask_width, true);
+		_set_solid_bit(y * mask_width + mask_width - 1, true);
 	}
 
 	for (int32_t y = region.position.y; y < end_y; y++) {
 		LocalVector<Point> line;
-		solid_mask.push_back(true);
 		for (int32_t x = region.position.x; x < end_x; x++) {
 			Vector2 v = offset;
 			switch (cell_shape) {
@@ -155,16 +202,10 @@ void AStarGrid2D::update() {
 					break;
 			}
 			line.push_back(Point(Vector2i(x, y), v));
-			solid_mask.push_back(false);
 		}
-		solid_mask.push_back(true);
 		points.push_back(line);
 	}
 
-	for (int32_t x = region.position.x; x < end_x + 2; x++) {
-		solid_mask.push_back(true);
-	}
-
 	dirty = false;
 }
 
@@ -269,6 +310,67 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 	}
 }
 
+uint64_t AStarGrid2D::_get_solid_bits(int64_t p_index) const {
+	// Bit N of the result is the solid bit at p_index + N. Bits outside of the mask read as solid.
+	if (p_index < 0) {
+		if (p_index <= -64) {
+			return ~uint64_t(0);
+		}
+		const uint32_t shift = -p_index;
+		return (_get_solid_bits(0) << shift) | ((uint64_t(1) << shift) - 1);
+	}
+
+	const size_t word = p_index >> 6;
+	const uint32_t shift = p_index & 63;
+	const uint64_t low = word < solid_mask.size() ? solid_mask[word] : ~uint64_t(0);
+	if (shift == 0) {
+		return low;
+	}
+	const uint64_t high = word + 1 < solid_mask.size() ? solid_mask[word + 1] : ~uint64_t(0);
+	return (low >> shift) | (high << (64 - shift));
+}
+
+AStarGrid2D::Point *AStarGrid2D::_scan_row(int32_t p_x, int32_t p_y, int32_t p_dx, bool p_inclusive) {
+	// Same as _forced_successor() for horizontal directions, but tests 64 cells of the row at once.
+	// A cell is forced when a cell above or below it opens up right after a solid one.
+	int32_t o_x = p_inclusive ? p_x + p_dx : p_x;
+	const int64_t stride = region.size.x + 2;
+	const int64_t side_offset = p_inclusive ? -p_dx : 0;
+	const bool end_in_row = end->id.y == p_y;
+
+	while (true) {
+		// When scanning to the left, the chunk ends at o_x so the nearest event is the highest bit.
+		const int64_t base = (int64_t)_to_mask_index(o_x, p_y) - (p_dx < 0 ? 63 : 0);
+
+		uint64_t blocked = _get_solid_bits(base);
+		uint64_t forced = 0;
+		for (int64_t side = -stride; side <= stride; side += 2 * stride) {
+			const uint64_t prev = _get_solid_bits(base + side + side_offset);
+			const uint64_t next = _get_solid_bits(base + side + side_offset + p_dx);
+			forced |= prev & ~next;
+		}
+
+		uint64_t events = blocked | forced;
+		if (end_in_row) {
+			const int32_t distance = (end->id.x - o_x) * p_dx;
+			if (distance >= 0 && distance < 64) {
+				events |= uint64_t(1) << (p_dx > 0 ? distance : 63 - distance);
+			}
+		}
+
+		if (events) {
+			const uint32_t bit = p_dx > 0 ? lowest_bit_index(events) : highest_bit_index(events);
+			if ((blocked >> bit) & 1) {
+				return nullptr;
+			}
+			const int32_t x = o_x + (p_dx > 0 ? (int32_t)bit : (int32_t)bit - 63);
+			return _get_point_unchecked(x, p_y);
+		}
+
+		o_x += 64 * p_dx;
+	}
+}
+
 AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 	int32_t from_x = p_from->id.x;
 	int32_t from_y = p_from->id.y;
@@ -349,6 +451,10 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 }
 
 AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive) {
+	if (p_dy == 0) {
+		return _scan_row(p_x, p_y, p_dx, p_inclusive);
+	}
+
 	// Remembering previous results can improve performance.
 	bool l_prev = false, r_prev = false, l = false, r = false;
 
@@ -108,7 +108,7 @@ private:
 		}
 	};
 
-	LocalVector<bool> solid_mask;
+	LocalVector<uint64_t> solid_mask; // One bit per cell, surrounded by a border of solid cells.
 	LocalVector<LocalVector<Point>> points;
 	Point *end = nullptr;
 	Point *last_closest_point = nullptr;
@@ -120,8 +120,21 @@ private: // Internal routines.
 		return ((p_y - region.position.y + 1) * (region.size.x + 2)) + p_x - region.position.x + 1;
 	}
 
+	_FORCE_INLINE_ bool _get_solid_bit(size_t p_index) const {
+		return (solid_mask[p_index >> 6] >> (p_index & 63)) & 1;
+	}
+
+	_FORCE_INLINE_ void _set_solid_bit(size_t p_index, bool p_solid) {
+		const uint64_t bit = uint64_t(1) << (p_index & 63);
+		if (p_solid) {
+			solid_mask[p_index >> 6] |= bit;
+		} else {
+			solid_mask[p_index >> 6] &= ~bit;
+		}
+	}
+
 	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
-		return !solid_mask[_to_mask_index(p_x, p_y)];
+		return !_get_solid_bit(_to_mask_index(p_x, p_y));
 	}
 
 	_FORCE_INLINE_ Point *_get_point(int32_t p_x, int32_t p_y) {
@@ -132,15 +145,15 @@ private: // Internal routines.
 	}
 
 	_FORCE_INLINE_ void _set_solid_unchecked(int32_t p_x, int32_t p_y, bool p_solid) {
-		solid_mask[_to_mask_index(p_x, p_y)] = p_solid;
+		_set_solid_bit(_to_mask_index(p_x, p_y), p_solid);
 	}
 
 	_FORCE_INLINE_ void _set_solid_unchecked(const Vector2i &p_id, bool p_solid) {
-		solid_mask[_to_mask_index(p_id.x, p_id.y)] = p_solid;
+		_set_solid_bit(_to_mask_index(p_id.x, p_id.y), p_solid);
 	}
 
 	_FORCE_INLINE_ bool _get_solid_unchecked(const Vector2i &p_id) const {
-		return solid_mask[_to_mask_index(p_id.x, p_id.y)];
+		return _get_solid_bit(_to_mask_index(p_id.x, p_id.y));
 	}
 
 	_FORCE_INLINE_ Point *_get_point_unchecked(int32_t p_x, int32_t p_y) {
@@ -156,6 +169,8 @@ private: // Internal routines.
 	}
 
 	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
+	uint64_t _get_solid_bits(int64_t p_index) const;
+	Point *_scan_row(int32_t p_x, int32_t p_y, int32_t p_dx, bool p_inclusive);
 	Point *_jump(Point *p_from, Point *p_to);
 	bool _solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
 	Point *_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive = false);
@@ -335,6 +335,7 @@ DynamicBVH::ID DynamicBVH::insert(const AABB &p_box, void *p_userdata) {
 	volume.max = p_box.position + p_box.size;
 
 	Node *leaf = _create_node_with_volume(nullptr, volume, p_userdata);
+	leaf->refit_volume = _get_refit_volume(volume);
 	_insert_leaf(bvh_root, leaf);
 	++total_leaves;
 
@@ -382,10 +383,50 @@ bool DynamicBVH::update(const ID &p_id, const AABB &p_box) {
 		}
 	}
 	leaf->volume = volume;
+	leaf->refit_volume = _get_refit_volume(volume);
 	_insert_leaf(base, leaf);
 	return true;
 }
 
+DynamicBVH::Volume DynamicBVH::_get_refit_volume(const Volume &p_volume) {
+	// Leaves can be refitted in place while they stay close to where they were inserted.
+	// Past that, the ancestors would keep growing and the tree quality would degrade.
+	const Vector3 margin = p_volume.get_length() * 0.25 + Vector3(CMP_EPSILON, CMP_EPSILON, CMP_EPSILON);
+	Volume refit_volume;
+	refit_volume.min = p_volume.min - margin;
+	refit_volume.max = p_volume.max + margin;
+	return refit_volume;
+}
+
+void DynamicBVH::refit(const ID *p_ids, const AABB *p_boxes, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		ERR_CONTINUE(!p_ids[i].is_valid());
+		Node *leaf = p_ids[i].node;
+
+		Volume volume;
+		volume.min = p_boxes[i].position;
+		volume.max = p_boxes[i].position + p_boxes[i].size;
+
+		if (!leaf->refit_volume.contains(volume)) {
+			// Moved too far to keep its place in the tree, reinsert it instead.
+			update(p_ids[i], p_boxes[i]);
+			continue;
+		}
+
+		leaf->volume = volume;
+
+		// Grow or shrink the ancestors in place. Stop at the first one that is not affected,
+		// leaves refitted earlier in the batch already took care of everything above it.
+		for (Node *node = leaf->parent; node; node = node->parent) {
+			const Volume merged = node->children[0]->volume.merge(node->children[1]->volume);
+			if (!merged.is_not_equal_to(node->volume)) {
+				break;
+			}
+			node->volume = merged;
+		}
+	}
+}
+
 void DynamicBVH::remove(const ID &p_id) {
 	ERR_FAIL_COND(!p_id.is_valid());
 	Node *leaf = p_id.node;
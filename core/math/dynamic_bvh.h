@@ -179,6 +179,7 @@ private:
 
 	struct Node {
 		Volume volume;
+		Volume refit_volume; // Leaves only, refit() reinserts the leaf once it leaves these bounds.
 		Node *parent = nullptr;
 		union {
 			Node *children[2];
@@ -246,6 +247,7 @@ private:
 	Node *_node_sort(Node *n, Node *&r);
 
 	_FORCE_INLINE_ void _update(Node *leaf, int lookahead = -1);
+	_FORCE_INLINE_ static Volume _get_refit_volume(const Volume &p_volume);
 
 	void _extract_leaves(Node *p_node, List<ID> *r_elements);
 
@@ -292,6 +294,7 @@ public:
 	void optimize_incremental(int passes);
 	ID insert(const AABB &p_box, void *p_userdata);
 	bool update(const ID &p_id, const AABB &p_box);
+	void refit(const ID *p_ids, const AABB *p_boxes, uint32_t p_count);
 	void remove(const ID &p_id);
 	void get_elements(List<ID> *r_elements);
 
@@ -69,6 +69,7 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		LocalVector<Task *> dependents; // Tasks to be posted once all its elements are processed.
 	};
 
 	struct Task {
@@ -89,6 +90,8 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t pending_dependencies = 0; // Not posted until this drops to zero.
+		LocalVector<Task *> dependents; // Tasks to be posted once this one completes.
 
 		void free_template_userdata();
 		Task() :
@@ -109,6 +112,22 @@ private:
 
 	BinaryMutex task_mutex;
 
+	// Chase-Lev work-stealing deque of tasks posted by a pool thread.
+	// Only the owner thread pushes (always with task_mutex held, so sleeping threads can't miss them)
+	// and pops (LIFO, lock-free); other threads steal from the opposite end (FIFO, lock-free).
+	struct LocalTaskQueue {
+		static const uint32_t CAPACITY = 256; // Must be a power of two. When full, tasks go to the shared queue.
+
+		std::atomic<int64_t> top = { 0 };
+		std::atomic<int64_t> bottom = { 0 };
+		std::atomic<Task *> buffer[CAPACITY];
+
+		bool push(Task *p_task);
+		Task *pop();
+		Task *steal();
+		_FORCE_INLINE_ bool is_empty() const { return bottom.load(std::memory_order_acquire) <= top.load(std::memory_order_acquire); }
+	};
+
 	struct ThreadData {
 		static Task *const YIELDING; // Too bad constexpr doesn't work here.
 
@@ -123,6 +142,7 @@ private:
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		LocalTaskQueue local_tasks;
 
 		ThreadData() :
 				signaled(false),
@@ -183,6 +203,12 @@ private:
 
 	bool _try_promote_low_priority_task();
 
+	void _resolve_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_ready);
+	void _post_ready_dependents(const LocalVector<Task *> &p_ready);
+
+	Task *_steal_task(const ThreadData *p_thief);
+	bool _has_local_tasks() const;
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -195,6 +221,7 @@ private:
 #endif
 
 	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false);
+	TaskID _add_dependent_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, Span<TaskID> p_dependencies, bool p_high_priority, const String &p_description);
 	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
 
 	template <typename C, typename M, typename U>
@@ -246,6 +273,19 @@ public:
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String(), bool p_pump_task = false);
 	TaskID add_task_bind(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Dependencies can be task or group IDs. The task is posted once all of them have finished.
+	template <typename C, typename M, typename U>
+	TaskID add_template_dependent_task(C *p_instance, M p_method, U p_userdata, Span<TaskID> p_dependencies, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_dependent_task(Callable(), nullptr, nullptr, ud, p_dependencies, p_high_priority, p_description);
+	}
+	TaskID add_native_dependent_task(void (*p_func)(void *), void *p_userdata, Span<TaskID> p_dependencies, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_dependent_task(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
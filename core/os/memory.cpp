@@ -32,7 +32,12 @@
 
 #include "core/templates/safe_refcount.h"
 
+#ifdef SMALL_ALLOCATOR_ENABLED
+#include "core/os/spin_lock.h"
+#endif
+
 #include <cstdlib>
+#include <cstring>
 
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
@@ -61,6 +66,307 @@ static SafeNumeric<uint64_t> _current_mem_usage;
 static SafeNumeric<uint64_t> _max_mem_usage;
 #endif
 
+#ifdef SMALL_ALLOCATOR_ENABLED
+
+// Small padded allocations are served from per size class free lists instead of the system
+// allocator. Every thread caches free blocks of each class and exchanges them in batches with
+// a central list, so neither allocating nor freeing (even a block allocated by another thread)
+// needs a lock in the common case. Blocks keep the regular size header, which is also what
+// tells which class a block belongs to when it's freed.
+
+static constexpr uint32_t SMALL_SIZE_CLASSES[] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+static constexpr uint32_t SMALL_SIZE_CLASS_COUNT = sizeof(SMALL_SIZE_CLASSES) / sizeof(SMALL_SIZE_CLASSES[0]);
+static constexpr uint32_t SMALL_SIZE_MAX = SMALL_SIZE_CLASSES[SMALL_SIZE_CLASS_COUNT - 1];
+static constexpr uint32_t SMALL_SLAB_SIZE = 64 * 1024;
+static constexpr uint32_t SMALL_CACHE_BATCH = 32; // Blocks exchanged with the central list at once.
+static constexpr uint32_t SMALL_CACHE_MAX = SMALL_CACHE_BATCH * 4; // Blocks a thread may hold on to per class.
+
+static_assert(Memory::DATA_OFFSET % 16 == 0, "Size class blocks must keep the data aligned.");
+
+struct SmallSizeClassLookup {
+	uint8_t classes[SMALL_SIZE_MAX / 16 + 1] = {};
+
+	constexpr SmallSizeClassLookup() {
+		uint32_t size_class = 0;
+		for (uint32_t i = 0; i <= SMALL_SIZE_MAX / 16; i++) {
+			while (SMALL_SIZE_CLASSES[size_class] < i * 16) {
+				size_class++;
+			}
+			classes[i] = size_class;
+		}
+	}
+};
+
+static constexpr SmallSizeClassLookup small_size_class_lookup;
+
+static _FORCE_INLINE_ uint32_t _get_small_size_class(size_t p_bytes) {
+	return small_size_class_lookup.classes[(p_bytes + 15) >> 4];
+}
+
+struct SmallFreeBlock {
+	SmallFreeBlock *next;
+};
+
+struct SmallSizeClassDepot {
+	SpinLock lock;
+	SmallFreeBlock *free_list = nullptr;
+	// Plain atomics so the depots are constant initialized, allocations may happen before dynamic initialization.
+	std::atomic<uint64_t> reserved_blocks{ 0 };
+	std::atomic<uint64_t> allocations{ 0 };
+	std::atomic<uint64_t> frees{ 0 };
+};
+
+static SmallSizeClassDepot small_depots[SMALL_SIZE_CLASS_COUNT];
+
+struct SmallThreadCache {
+	struct SizeClass {
+		SmallFreeBlock *free_list;
+		uint32_t count;
+		// Statistics are only merged into the depot when exchanging batches.
+		uint32_t allocations;
+		uint32_t frees;
+	};
+
+	SizeClass classes[SMALL_SIZE_CLASS_COUNT];
+	bool released; // Thread is exiting, go straight to the depots.
+};
+
+// Trivially destructible, so it stays usable after the releaser below ran.
+static thread_local SmallThreadCache small_thread_cache;
+
+static void _small_flush_stats(uint32_t p_class) {
+	SmallThreadCache::SizeClass &cache = small_thread_cache.classes[p_class];
+	SmallSizeClassDepot &depot = small_depots[p_class];
+	if (cache.allocations) {
+		depot.allocations.fetch_add(cache.allocations, std::memory_order_relaxed);
+		cache.allocations = 0;
+	}
+	if (cache.frees) {
+		depot.frees.fetch_add(cache.frees, std::memory_order_relaxed);
+		cache.frees = 0;
+	}
+}
+
+// Give the blocks of a list back to the depot.
+static void _small_depot_push(uint32_t p_class, SmallFreeBlock *p_first, SmallFreeBlock *p_last) {
+	SmallSizeClassDepot &depot = small_depots[p_class];
+	depot.lock.lock();
+	p_last->next = depot.free_list;
+	depot.free_list = p_first;
+	depot.lock.unlock();
+}
+
+struct SmallThreadCacheReleaser {
+	bool active = false;
+
+	~SmallThreadCacheReleaser() {
+		for (uint32_t i = 0; i < SMALL_SIZE_CLASS_COUNT; i++) {
+			SmallThreadCache::SizeClass &cache = small_thread_cache.classes[i];
+			if (cache.free_list) {
+				SmallFreeBlock *last = cache.free_list;
+				while (last->next) {
+					last = last->next;
+				}
+				_small_depot_push(i, cache.free_list, last);
+				cache.free_list = nullptr;
+				cache.count = 0;
+			}
+			_small_flush_stats(i);
+		}
+		small_thread_cache.released = true;
+	}
+};
+
+// Accessing it registers its destructor, which returns the cached blocks when the thread exits.
+static thread_local SmallThreadCacheReleaser small_thread_cache_releaser;
+
+static void *_small_alloc_slow(uint32_t p_class) {
+	SmallThreadCache::SizeClass &cache = small_thread_cache.classes[p_class];
+	SmallSizeClassDepot &depot = small_depots[p_class];
+	const bool released = small_thread_cache.released;
+	if (!released) {
+		small_thread_cache_releaser.active = true;
+	}
+
+	// One block to return, plus a batch for the cache.
+	const uint32_t wanted = released ? 1 : SMALL_CACHE_BATCH + 1;
+
+	depot.lock.lock();
+	SmallFreeBlock *first = depot.free_list;
+	SmallFreeBlock *last = first;
+	uint32_t count = 0;
+	if (first) {
+		count = 1;
+		while (count < wanted && last->next) {
+			last = last->next;
+			count++;
+		}
+		depot.free_list = last->next;
+		last->next = nullptr;
+	}
+	depot.lock.unlock();
+
+	if (!first) {
+		// Carve a new slab, it is never given back to the system.
+		const uint32_t block_size = Memory::DATA_OFFSET + SMALL_SIZE_CLASSES[p_class];
+		const uint32_t block_count = SMALL_SLAB_SIZE / block_size;
+		uint8_t *slab = (uint8_t *)malloc(size_t(block_size) * block_count);
+		if (!slab) {
+			return nullptr;
+		}
+		depot.reserved_blocks.fetch_add(block_count, std::memory_order_relaxed);
+
+		first = (SmallFreeBlock *)slab;
+		count = MIN(wanted, block_count);
+		for (uint32_t i = 0; i < block_count - 1; i++) {
+			((SmallFreeBlock *)(slab + size_t(i) * block_size))->next = (SmallFreeBlock *)(slab + size_t(i + 1) * block_size);
+		}
+		((SmallFreeBlock *)(slab + size_t(block_count - 1) * block_size))->next = nullptr;
+
+		if (block_count > count) {
+			last = (SmallFreeBlock *)(slab + size_t(count - 1) * block_size);
+			_small_depot_push(p_class, last->next, (SmallFreeBlock *)(slab + size_t(block_count - 1) * block_size));
+			last->next = nullptr;
+		}
+	}
+
+	SmallFreeBlock *block = first;
+	if (released) {
+		depot.allocations.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		cache.free_list = block->next;
+		cache.count = count - 1;
+		cache.allocations++;
+		_small_flush_stats(p_class);
+	}
+	return block;
+}
+
+static _FORCE_INLINE_ void *_small_alloc(uint32_t p_class) {
+	SmallThreadCache::SizeClass &cache = small_thread_cache.classes[p_class];
+	SmallFreeBlock *block = cache.free_list;
+	if (likely(block)) {
+		cache.free_list = block->next;
+		cache.count--;
+		cache.allocations++;
+		return block;
+	}
+	return _small_alloc_slow(p_class);
+}
+
+static void _small_free_slow(uint32_t p_class) {
+	SmallThreadCache::SizeClass &cache = small_thread_cache.classes[p_class];
+
+	// Keep the most recently freed blocks, hand a batch of the older ones to the depot.
+	SmallFreeBlock *keep_last = cache.free_list;
+	for (uint32_t i = 1; i < cache.count - SMALL_CACHE_BATCH; i++) {
+		keep_last = keep_last->next;
+	}
+	SmallFreeBlock *first = keep_last->next;
+	SmallFreeBlock *last = first;
+	while (last->next) {
+		last = last->next;
+	}
+	keep_last->next = nullptr;
+	cache.count -= SMALL_CACHE_BATCH;
+
+	_small_depot_push(p_class, first, last);
+	_small_flush_stats(p_class);
+}
+
+static _FORCE_INLINE_ void _small_free(void *p_block, uint32_t p_class) {
+	SmallFreeBlock *block = (SmallFreeBlock *)p_block;
+	if (unlikely(small_thread_cache.released)) {
+		block->next = nullptr;
+		_small_depot_push(p_class, block, block);
+		small_depots[p_class].frees.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	SmallThreadCache::SizeClass &cache = small_thread_cache.classes[p_class];
+	if (unlikely(cache.count == 0)) {
+		// May be a thread that only ever frees, make sure its cache is given back on exit.
+		small_thread_cache_releaser.active = true;
+	}
+	block->next = cache.free_list;
+	cache.free_list = block;
+	cache.count++;
+	cache.frees++;
+	if (unlikely(cache.count > SMALL_CACHE_MAX)) {
+		_small_free_slow(p_class);
+	}
+}
+
+uint32_t Memory::get_size_class_count() {
+	return SMALL_SIZE_CLASS_COUNT;
+}
+
+Memory::SizeClassStats Memory::get_size_class_stats(uint32_t p_class) {
+	SizeClassStats stats;
+	ERR_FAIL_UNSIGNED_INDEX_V(p_class, SMALL_SIZE_CLASS_COUNT, stats);
+	const SmallSizeClassDepot &depot = small_depots[p_class];
+	stats.size = SMALL_SIZE_CLASSES[p_class];
+	stats.reserved_blocks = depot.reserved_blocks.load(std::memory_order_relaxed);
+	stats.allocations = depot.allocations.load(std::memory_order_relaxed);
+	stats.frees = depot.frees.load(std::memory_order_relaxed);
+	return stats;
+}
+
+#endif // SMALL_ALLOCATOR_ENABLED
+
+// Allocation and release of padded blocks, p_bytes not including the padding.
+template <bool p_ensure_zero>
+static _FORCE_INLINE_ void *_alloc_padded(size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	if (p_bytes <= SMALL_SIZE_MAX) {
+		void *mem = _small_alloc(_get_small_size_class(p_bytes));
+		if constexpr (p_ensure_zero) {
+			if (mem) {
+				memset(mem, 0, Memory::DATA_OFFSET + p_bytes);
+			}
+		}
+		return mem;
+	}
+#endif
+	if constexpr (p_ensure_zero) {
+		return calloc(1, p_bytes + Memory::DATA_OFFSET);
+	} else {
+		return malloc(p_bytes + Memory::DATA_OFFSET);
+	}
+}
+
+static _FORCE_INLINE_ void _free_padded(void *p_mem, size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	if (p_bytes <= SMALL_SIZE_MAX) {
+		_small_free(p_mem, _get_small_size_class(p_bytes));
+		return;
+	}
+#endif
+	free(p_mem);
+}
+
+static _FORCE_INLINE_ void *_realloc_padded(void *p_mem, size_t p_prev_bytes, size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	if (p_prev_bytes <= SMALL_SIZE_MAX || p_bytes <= SMALL_SIZE_MAX) {
+		if (p_prev_bytes <= SMALL_SIZE_MAX && p_bytes <= SMALL_SIZE_MAX && _get_small_size_class(p_prev_bytes) == _get_small_size_class(p_bytes)) {
+			return p_mem;
+		}
+		void *mem = _alloc_padded<false>(p_bytes);
+		if (mem) {
+			memcpy(mem, p_mem, Memory::DATA_OFFSET + MIN(p_prev_bytes, p_bytes));
+			_free_padded(p_mem, p_prev_bytes);
+		}
+		return mem;
+	}
+#endif
+	return realloc(p_mem, p_bytes + Memory::DATA_OFFSET);
+}
+
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
 	DEV_ASSERT(is_power_of_2(p_alignment));
 
@@ -95,17 +401,19 @@ void Memory::free_aligned_static(void *p_memory) {
 
 template <bool p_ensure_zero>
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
 	void *mem;
-	if constexpr (p_ensure_zero) {
-		mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
+	if (prepad) {
+		mem = _alloc_padded<p_ensure_zero>(p_bytes);
+	} else if constexpr (p_ensure_zero) {
+		mem = calloc(1, p_bytes);
 	} else {
-		mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+		mem = malloc(p_bytes);
 	}
 
 	ERR_FAIL_NULL_V(mem, nullptr);
@@ -136,7 +444,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -145,6 +453,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+		const uint64_t prev_bytes = *s;
 
 #ifdef DEBUG_ENABLED
 		if (p_bytes > *s) {
@@ -156,12 +465,12 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_free_padded(mem, prev_bytes);
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+			mem = (uint8_t *)_realloc_padded(mem, prev_bytes, p_bytes);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
@@ -184,7 +493,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -193,12 +502,12 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
-#ifdef DEBUG_ENABLED
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+#ifdef DEBUG_ENABLED
 		_current_mem_usage.sub(*s);
 #endif
 
-		free(mem);
+		_free_padded(mem, *s);
 	} else {
 		free(mem);
 	}
@@ -87,6 +87,20 @@ void free_aligned_static(void *p_memory);
 uint64_t get_mem_available();
 uint64_t get_mem_usage();
 uint64_t get_mem_max_usage();
+
+#ifdef SMALL_ALLOCATOR_ENABLED
+// Statistics of the built-in size class allocator. Threads merge their counters when exchanging
+// blocks with the shared lists, so allocations and frees may lag behind by a few blocks.
+struct SizeClassStats {
+	uint32_t size = 0; // Largest allocation served by the class, in bytes.
+	uint64_t reserved_blocks = 0;
+	uint64_t allocations = 0;
+	uint64_t frees = 0;
+};
+
+uint32_t get_size_class_count();
+SizeClassStats get_size_class_stats(uint32_t p_class);
+#endif
 }; //namespace Memory
 
 class DefaultAllocator {
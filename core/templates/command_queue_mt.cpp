@@ -30,9 +30,27 @@
 
 #include "command_queue_mt.h"
 
+#include "core/os/os.h"
+
+uint64_t CommandQueueMT::_get_ticks_usec() {
+	const OS *os = OS::get_singleton();
+	return os ? os->get_ticks_usec() : 0;
+}
+
 CommandQueueMT::CommandQueueMT() {
-	command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+	read_block = memnew(Block);
+	write_block = read_block;
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	while (read_block) {
+		Block *next = read_block->next;
+		memdelete(read_block);
+		read_block = next;
+	}
+	while (free_blocks) {
+		Block *next = free_blocks->next;
+		memdelete(free_blocks);
+		free_blocks = next;
+	}
 }
@@ -33,7 +33,6 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/condition_variable.h"
 #include "core/os/mutex.h"
-#include "core/templates/local_vector.h"
 #include "core/templates/simple_type.h"
 #include "core/templates/tuple.h"
 #include "core/typedefs.h"
@@ -103,29 +102,79 @@ class CommandQueueMT {
 
 	/***** BASE *******/
 
-	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
+	static const uint32_t COMMAND_BLOCK_SIZE_KB = 64;
 
+	// Commands are written to a list of fixed size blocks, so they never move once created
+	// (even while the queue is unlocked during a flush). Consumed blocks are kept for reuse,
+	// nothing is allocated once the queue has grown to its working size.
+	struct Block {
+		Block *next = nullptr;
+		uint32_t size = 0;
+		alignas(8) uint8_t data[COMMAND_BLOCK_SIZE_KB * 1024];
+	};
+
+public:
+	struct Stats {
+		uint64_t peak_size = 0; // Largest amount of command memory queued at once, in bytes.
+		uint64_t last_flush_latency_usec = 0; // Time between the first command entering an empty queue and the end of the flush that ran it.
+		uint64_t max_flush_latency_usec = 0;
+	};
+
+private:
 	BinaryMutex mutex;
-	LocalVector<uint8_t> command_mem;
+	Block *read_block = nullptr;
+	Block *write_block = nullptr;
+	Block *free_blocks = nullptr;
+	uint64_t queued_size = 0;
+	uint64_t pending_since_usec = 0;
+	Stats stats;
 	ConditionVariable sync_cond_var;
 	uint32_t sync_head = 0;
 	uint32_t sync_tail = 0;
 	uint32_t sync_awaiters = 0;
 	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
-	uint64_t flush_read_ptr = 0;
+	Block *flush_block = nullptr;
+	uint32_t flush_read_ptr = 0;
 	std::atomic<bool> pending{ false };
 
+	static uint64_t _get_ticks_usec();
+
+	void _push_block() {
+		Block *block = free_blocks;
+		if (block) {
+			free_blocks = block->next;
+			block->next = nullptr;
+			block->size = 0;
+		} else {
+			block = memnew(Block);
+		}
+		write_block->next = block;
+		write_block = block;
+	}
+
 	template <typename T, typename... Args>
 	_FORCE_INLINE_ void create_command(Args &&...p_args) {
 		// alloc size is size+T+safeguard
-		constexpr uint64_t alloc_size = ((sizeof(T) + 8U - 1U) & ~(8U - 1U));
-		static_assert(alloc_size < UINT32_MAX, "Type too large to fit in the command queue.");
-
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + sizeof(uint64_t));
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		void *cmd = &command_mem[size + sizeof(uint64_t)];
-		new (cmd) T(std::forward<Args>(p_args)...);
+		constexpr uint32_t alloc_size = ((sizeof(T) + 8U - 1U) & ~(8U - 1U));
+		static_assert(alloc_size + sizeof(uint64_t) <= sizeof(Block::data), "Type too large to fit in the command queue.");
+
+		constexpr uint32_t total_size = alloc_size + sizeof(uint64_t);
+		if (unlikely(write_block->size + total_size > sizeof(Block::data))) {
+			_push_block();
+		}
+
+		uint8_t *mem = &write_block->data[write_block->size];
+		*(uint64_t *)mem = alloc_size;
+		new (mem + sizeof(uint64_t)) T(std::forward<Args>(p_args)...);
+		write_block->size += total_size;
+
+		if (queued_size == 0) {
+			pending_since_usec = _get_ticks_usec();
+		}
+		queued_size += total_size;
+		if (queued_size > stats.peak_size) {
+			stats.peak_size = queued_size;
+		}
 		pending.store(true);
 	}
 
@@ -154,42 +203,61 @@ class CommandQueueMT {
 	}
 
 	void _flush() {
-		if (unlikely(flush_read_ptr)) {
+		if (unlikely(flush_block)) {
 			// Re-entrant call.
 			return;
 		}
 
 		MutexLock lock(mutex);
 
-		while (flush_read_ptr < command_mem.size()) {
-			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
-			flush_read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(lock);
-			cmd->call();
-			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
-
-			// Handle potential realloc due to the command and unlock allowance.
-			cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-
-			if (unlikely(cmd->sync)) {
-				sync_head++;
-				lock.~MutexLock(); // Give an opportunity to awaiters right away.
-				sync_cond_var.notify_all();
-				new (&lock) MutexLock(mutex);
-				// Handle potential realloc happened during unlock.
-				cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
+		flush_block = read_block;
+		while (true) {
+			while (flush_read_ptr < flush_block->size) {
+				uint64_t size = *(uint64_t *)&flush_block->data[flush_read_ptr];
+				flush_read_ptr += 8;
+				CommandBase *cmd = reinterpret_cast<CommandBase *>(&flush_block->data[flush_read_ptr]);
+				uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(lock);
+				cmd->call();
+				WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+
+				if (unlikely(cmd->sync)) {
+					sync_head++;
+					lock.~MutexLock(); // Give an opportunity to awaiters right away.
+					sync_cond_var.notify_all();
+					new (&lock) MutexLock(mutex);
+				}
+
+				cmd->~CommandBase();
+
+				flush_read_ptr += size;
 			}
 
-			cmd->~CommandBase();
+			if (flush_block == write_block) {
+				break;
+			}
 
-			flush_read_ptr += size;
+			// Block fully consumed, keep it around for reuse.
+			Block *consumed = flush_block;
+			flush_block = consumed->next;
+			flush_read_ptr = 0;
+			consumed->next = free_blocks;
+			free_blocks = consumed;
 		}
 
-		command_mem.clear();
+		read_block = flush_block;
+		read_block->size = 0;
 		pending.store(false);
+		flush_block = nullptr;
 		flush_read_ptr = 0;
 
+		if (queued_size) {
+			stats.last_flush_latency_usec = _get_ticks_usec() - pending_since_usec;
+			if (stats.last_flush_latency_usec > stats.max_flush_latency_usec) {
+				stats.max_flush_latency_usec = stats.last_flush_latency_usec;
+			}
+			queued_size = 0;
+		}
+
 		_prevent_sync_wraparound();
 	}
 
@@ -252,6 +320,16 @@ public:
 		pump_task_id = p_task_id;
 	}
 
+	Stats get_stats() {
+		MutexLock lock(mutex);
+		return stats;
+	}
+
+	void reset_stats() {
+		MutexLock lock(mutex);
+		stats = Stats();
+	}
+
 	CommandQueueMT();
 	~CommandQueueMT();
 };
@@ -47,6 +47,8 @@ class FileAccessWindows : public FileAccess {
 	String path;
 	String path_src;
 	String save_path;
+	void *mapping_handle = nullptr;
+	const uint8_t *mapped = nullptr;
 
 	void _close();
 
@@ -70,6 +72,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *map_read_only() override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -556,6 +556,11 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 
+		if (Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, Variant::NIL) == Variant::BOOL) {
+			last_bool_operator_pos = opcodes.size();
+			last_bool_operator_target = p_target;
+		}
+
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(Address());
@@ -581,6 +586,62 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 }
 
+// Returns the opcode working directly on values of the given type, or `OPCODE_END` if there is none.
+static GDScriptFunction::Opcode _get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_type) {
+#define TYPED_OPERATOR_CASE(m_op, m_type) \
+	case Variant::OP_##m_op:              \
+		return GDScriptFunction::OPCODE_OPERATOR_##m_op##_##m_type
+
+	switch (p_type) {
+		case Variant::INT:
+			// Integer division and modulo are not here, since they must check for division by zero.
+			switch (p_operator) {
+				TYPED_OPERATOR_CASE(ADD, INT);
+				TYPED_OPERATOR_CASE(SUBTRACT, INT);
+				TYPED_OPERATOR_CASE(MULTIPLY, INT);
+				default:
+					break;
+			}
+			break;
+		case Variant::FLOAT:
+			switch (p_operator) {
+				TYPED_OPERATOR_CASE(ADD, FLOAT);
+				TYPED_OPERATOR_CASE(SUBTRACT, FLOAT);
+				TYPED_OPERATOR_CASE(MULTIPLY, FLOAT);
+				TYPED_OPERATOR_CASE(DIVIDE, FLOAT);
+				default:
+					break;
+			}
+			break;
+		case Variant::VECTOR2:
+			switch (p_operator) {
+				TYPED_OPERATOR_CASE(ADD, VECTOR2);
+				TYPED_OPERATOR_CASE(SUBTRACT, VECTOR2);
+				TYPED_OPERATOR_CASE(MULTIPLY, VECTOR2);
+				TYPED_OPERATOR_CASE(DIVIDE, VECTOR2);
+				default:
+					break;
+			}
+			break;
+		case Variant::VECTOR3:
+			switch (p_operator) {
+				TYPED_OPERATOR_CASE(ADD, VECTOR3);
+				TYPED_OPERATOR_CASE(SUBTRACT, VECTOR3);
+				TYPED_OPERATOR_CASE(MULTIPLY, VECTOR3);
+				TYPED_OPERATOR_CASE(DIVIDE, VECTOR3);
+				default:
+					break;
+			}
+			break;
+		default:
+			break;
+	}
+
+#undef TYPED_OPERATOR_CASE
+
+	return GDScriptFunction::OPCODE_END;
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	bool valid = HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand);
 
@@ -602,17 +663,34 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	}
 
 	if (valid) {
+		Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 		if (p_target.mode == Address::TEMPORARY) {
-			Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 			Variant::Type temp_type = temporaries[p_target.address].type;
 			if (result_type != temp_type) {
 				write_type_adjust(p_target, result_type);
 			}
 		}
 
+		if (p_left_operand.type.builtin_type == p_right_operand.type.builtin_type) {
+			// Arithmetic between values of the same type can skip the evaluator indirection.
+			GDScriptFunction::Opcode typed_opcode = _get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type);
+			if (typed_opcode != GDScriptFunction::OPCODE_END) {
+				append_opcode(typed_opcode);
+				append(p_left_operand);
+				append(p_right_operand);
+				append(p_target);
+				return;
+			}
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		if (result_type == Variant::BOOL) {
+			last_bool_operator_pos = opcodes.size();
+			last_bool_operator_target = p_target;
+		}
+
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
@@ -1508,7 +1586,24 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 	append(p_target);
 }
 
+void GDScriptByteCodeGenerator::fuse_bool_operator_jump(const Address &p_condition) {
+	// A validated operator has 4 arguments, so it must be the instruction just before the jump.
+	if (last_bool_operator_pos < 0 || last_bool_operator_pos + 5 != opcodes.size()) {
+		return;
+	}
+	if (last_bool_operator_target.mode != p_condition.mode || last_bool_operator_target.address != p_condition.address) {
+		return;
+	}
+
+	// Only the opcode is replaced, the layout is kept as is. The fused instruction evaluates the
+	// operator and then handles the following jump, which stays in place as a valid instruction
+	// in case something else jumps right to it.
+	opcodes.write[last_bool_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+	last_bool_operator_pos = -1;
+}
+
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
+	fuse_bool_operator_jump(p_condition);
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
@@ -1784,6 +1879,7 @@ void GDScriptByteCodeGenerator::start_while_condition() {
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
+	fuse_bool_operator_jump(p_condition);
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
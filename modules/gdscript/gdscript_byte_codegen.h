@@ -162,6 +162,12 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+	// Last validated operator producing a `bool`, so a conditional jump right after it can be fused.
+	int last_bool_operator_pos = -1;
+	Address last_bool_operator_target;
+
+	void fuse_bool_operator_jump(const Address &p_condition);
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
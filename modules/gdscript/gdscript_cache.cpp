@@ -296,6 +296,11 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 }
 
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
+	Ref<GDScriptParserRef> parser_ref;
+	return _get_shallow_script(p_path, r_error, p_owner, parser_ref);
+}
+
+Ref<GDScript> GDScriptCache::_get_shallow_script(const String &p_path, Error &r_error, const String &p_owner, Ref<GDScriptParserRef> &r_parser_ref) {
 	MutexLock lock(singleton->mutex);
 
 	if (!p_owner.is_empty()) {
@@ -327,9 +332,9 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+	r_parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
 	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		GDScriptCompiler::make_scripts(script.ptr(), r_parser_ref->get_parser()->get_tree(), true);
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -353,8 +358,11 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		}
 	}
 
+	// Keep the tree parsed for the shallow script alive until the script is reloaded,
+	// so `GDScript::reload()` can analyze it instead of parsing the same source again.
+	Ref<GDScriptParserRef> shallow_parser_ref;
 	if (script.is_null()) {
-		script = get_shallow_script(p_path, r_error);
+		script = _get_shallow_script(p_path, r_error, String(), shallow_parser_ref);
 		// Only exit early if script failed to load, otherwise let reload report errors.
 		if (script.is_null()) {
 			return script;
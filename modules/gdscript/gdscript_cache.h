@@ -103,6 +103,8 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> mutex;
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
+	static Ref<GDScript> _get_shallow_script(const String &p_path, Error &r_error, const String &p_owner, Ref<GDScriptParserRef> &r_parser_ref);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
@@ -141,6 +141,51 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += " and jump-if-not to ";
+				text += itos(_code_ptr[ip + 7]);
+
+				incr += 8;
+			} break;
+
+#define DISASSEMBLE_TYPED_OPERATOR(m_op, m_type, m_operator) \
+	case OPCODE_OPERATOR_##m_op##_##m_type: {                \
+		text += "typed operator (";                          \
+		text += #m_type;                                     \
+		text += ") ";                                        \
+		text += DADDR(3);                                    \
+		text += " = ";                                       \
+		text += DADDR(1);                                    \
+		text += " " m_operator " ";                          \
+		text += DADDR(2);                                    \
+		incr += 4;                                           \
+	} break
+
+				DISASSEMBLE_TYPED_OPERATOR(ADD, INT, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT, INT, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY, INT, "*");
+				DISASSEMBLE_TYPED_OPERATOR(ADD, FLOAT, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT, FLOAT, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY, FLOAT, "*");
+				DISASSEMBLE_TYPED_OPERATOR(DIVIDE, FLOAT, "/");
+				DISASSEMBLE_TYPED_OPERATOR(ADD, VECTOR2, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT, VECTOR2, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY, VECTOR2, "*");
+				DISASSEMBLE_TYPED_OPERATOR(DIVIDE, VECTOR2, "/");
+				DISASSEMBLE_TYPED_OPERATOR(ADD, VECTOR3, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT, VECTOR3, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY, VECTOR3, "*");
+				DISASSEMBLE_TYPED_OPERATOR(DIVIDE, VECTOR3, "/");
+#undef DISASSEMBLE_TYPED_OPERATOR
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -254,6 +254,22 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_OPERATOR_ADD_INT,                       \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,                  \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,                  \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                     \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,                \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,                \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,                  \
+		&&OPCODE_OPERATOR_ADD_VECTOR2,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR2,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2,              \
+		&&OPCODE_OPERATOR_DIVIDE_VECTOR2,                \
+		&&OPCODE_OPERATOR_ADD_VECTOR3,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3,              \
+		&&OPCODE_OPERATOR_DIVIDE_VECTOR3,                \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -849,6 +865,59 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				// Validated operator returning `bool`, fused with the `OPCODE_JUMP_IF_NOT` testing its result.
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
+// Operands and destination are already known to be of the given type, so the values are used in place.
+#define OPCODE_TYPED_OPERATOR(m_op, m_type, m_get_func, m_operator)                                                     \
+	OPCODE(OPCODE_OPERATOR_##m_op##_##m_type) {                                                                         \
+		CHECK_SPACE(4);                                                                                                 \
+		GET_VARIANT_PTR(a, 0);                                                                                          \
+		GET_VARIANT_PTR(b, 1);                                                                                          \
+		GET_VARIANT_PTR(dst, 2);                                                                                        \
+		*VariantInternal::m_get_func(dst) = *VariantInternal::m_get_func(a) m_operator *VariantInternal::m_get_func(b); \
+		ip += 4;                                                                                                        \
+	}                                                                                                                   \
+	DISPATCH_OPCODE
+
+			OPCODE_TYPED_OPERATOR(ADD, INT, get_int, +);
+			OPCODE_TYPED_OPERATOR(SUBTRACT, INT, get_int, -);
+			OPCODE_TYPED_OPERATOR(MULTIPLY, INT, get_int, *);
+			OPCODE_TYPED_OPERATOR(ADD, FLOAT, get_float, +);
+			OPCODE_TYPED_OPERATOR(SUBTRACT, FLOAT, get_float, -);
+			OPCODE_TYPED_OPERATOR(MULTIPLY, FLOAT, get_float, *);
+			OPCODE_TYPED_OPERATOR(DIVIDE, FLOAT, get_float, /);
+			OPCODE_TYPED_OPERATOR(ADD, VECTOR2, get_vector2, +);
+			OPCODE_TYPED_OPERATOR(SUBTRACT, VECTOR2, get_vector2, -);
+			OPCODE_TYPED_OPERATOR(MULTIPLY, VECTOR2, get_vector2, *);
+			OPCODE_TYPED_OPERATOR(DIVIDE, VECTOR2, get_vector2, /);
+			OPCODE_TYPED_OPERATOR(ADD, VECTOR3, get_vector3, +);
+			OPCODE_TYPED_OPERATOR(SUBTRACT, VECTOR3, get_vector3, -);
+			OPCODE_TYPED_OPERATOR(MULTIPLY, VECTOR3, get_vector3, *);
+			OPCODE_TYPED_OPERATOR(DIVIDE, VECTOR3, get_vector3, /);
+#undef OPCODE_TYPED_OPERATOR
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
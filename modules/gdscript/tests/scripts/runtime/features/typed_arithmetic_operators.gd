@@ -0,0 +1,24 @@
+# Arithmetic between statically typed values of the same type uses dedicated opcodes.
+
+func test():
+	var a: int = 7
+	var b: int = -3
+	print(a + b, " ", a - b, " ", a * b)
+	a += b
+	print(a)
+
+	var x: float = 1.5
+	var y: float = 0.5
+	print(x + y, " ", x - y, " ", x * y, " ", x / y)
+	print(x / 0.0)
+
+	var v2 := Vector2(4, 6)
+	var w2 := Vector2(2, 3)
+	print(v2 + w2, " ", v2 - w2, " ", v2 * w2, " ", v2 / w2)
+
+	var v3 := Vector3(4, 6, 8)
+	var w3 := Vector3(2, 3, 4)
+	print(v3 + w3, " ", v3 - w3, " ", v3 * w3, " ", v3 / w3)
+
+	# Mixed types still go through the validated evaluators.
+	print(a * x, " ", v2 * 2)
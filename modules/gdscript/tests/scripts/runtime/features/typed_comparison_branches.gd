@@ -0,0 +1,36 @@
+# Typed comparisons used directly as `if`/`while` conditions are compiled
+# into a single instruction that evaluates the operator and jumps.
+
+func test():
+	var i: int = 0
+	var total: int = 0
+	while i < 5:
+		total += i
+		i += 1
+	print(total)
+
+	var f: float = 0.5
+	if f > 1.0:
+		print("greater")
+	elif f <= 0.5:
+		print("less or equal")
+	else:
+		print("unreachable")
+
+	var flag: bool = false
+	if not flag:
+		print("not flag")
+
+	var v := Vector2(1, 2)
+	if v == Vector2(1, 2):
+		print("equal vectors")
+
+	# Jumping back to a fused condition from `continue`.
+	var odd: Array[int] = []
+	var n: int = 0
+	while n < 6:
+		n += 1
+		if n % 2 == 0:
+			continue
+		odd.push_back(n)
+	print(odd)
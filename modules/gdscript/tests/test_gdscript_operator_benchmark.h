@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  test_gdscript_operator_benchmark.h                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#pragma once
+
+#include "../gdscript.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+// Compares statically typed arithmetic, which compiles to typed operator opcodes,
+// with the same code on untyped variables going through Variant evaluation.
+// Skipped by default, run with `--test --test-case="*[Benchmark]*" --no-skip`.
+TEST_CASE("[Modules][GDScript][Benchmark] Typed and untyped arithmetic" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func int_typed(p_count: int) -> int:
+	var total: int = 0
+	var i: int = 0
+	while i < p_count:
+		total = total + i * 3 - 1
+		i += 1
+	return total
+
+func int_untyped(p_count):
+	var total = 0
+	var i = 0
+	while i < p_count:
+		total = total + i * 3 - 1
+		i += 1
+	return total
+
+func float_typed(p_count: int) -> float:
+	var total: float = 0.0
+	var x: float = 0.5
+	for i: int in p_count:
+		total = total + x * 1.5 - x / 3.0
+	return total
+
+func float_untyped(p_count):
+	var total = 0.0
+	var x = 0.5
+	for i in p_count:
+		total = total + x * 1.5 - x / 3.0
+	return total
+
+func vector2_typed(p_count: int) -> Vector2:
+	var total := Vector2()
+	var step := Vector2(0.5, 0.25)
+	for i: int in p_count:
+		total = total + step * step - step / Vector2(2.0, 4.0)
+	return total
+
+func vector2_untyped(p_count):
+	var total = Vector2()
+	var step = Vector2(0.5, 0.25)
+	for i in p_count:
+		total = total + step * step - step / Vector2(2.0, 4.0)
+	return total
+
+func vector3_typed(p_count: int) -> Vector3:
+	var total := Vector3()
+	var step := Vector3(0.5, 0.25, 0.125)
+	for i: int in p_count:
+		total = total + step * step - step / Vector3(2.0, 4.0, 8.0)
+	return total
+
+func vector3_untyped(p_count):
+	var total = Vector3()
+	var step = Vector3(0.5, 0.25, 0.125)
+	for i in p_count:
+		total = total + step * step - step / Vector3(2.0, 4.0, 8.0)
+	return total
+)");
+	const Error error = gdscript->reload();
+	REQUIRE_MESSAGE(error == OK, "The benchmark script should parse successfully.");
+
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(gdscript);
+
+	const int count = 1000000;
+	const char *kinds[] = { "int", "float", "vector2", "vector3" };
+	for (const char *kind : kinds) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		Variant typed_result = instance->call(vformat("%s_typed", kind), count);
+		uint64_t typed_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		Variant untyped_result = instance->call(vformat("%s_untyped", kind), count);
+		uint64_t untyped_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		CHECK_MESSAGE(typed_result == untyped_result, vformat("Typed and untyped %s arithmetic should give the same result.", kind));
+		MESSAGE(vformat("%s: typed %d usec, untyped %d usec (%.2fx).", kind, typed_usec, untyped_usec, double(untyped_usec) / MAX(1.0, double(typed_usec))));
+	}
+}
+
+} // namespace GDScriptTests
@@ -503,6 +503,23 @@ bool GodotBodyPair2D::pre_solve(real_t p_step) {
 	return do_process;
 }
 
+bool GodotBodyPair2D::is_pre_solve_thread_safe() const {
+	if (space->is_debugging_contacts()) {
+		// Debug contacts are written to a buffer shared by the whole space.
+		return false;
+	}
+
+	// Static bodies don't connect islands, so they can be shared between them.
+	if (A->get_mode() == PhysicsServer2D::BODY_MODE_STATIC && A->can_report_contacts()) {
+		return false;
+	}
+	if (B->get_mode() == PhysicsServer2D::BODY_MODE_STATIC && B->can_report_contacts()) {
+		return false;
+	}
+
+	return true;
+}
+
 void GodotBodyPair2D::solve(real_t p_step) {
 	if (!collided || oneway_disabled) {
 		return;
@@ -63,5 +63,8 @@ public:
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
+	// Whether pre_solve() only modifies objects from its own island, so it can run concurrently with other islands.
+	virtual bool is_pre_solve_thread_safe() const { return false; }
+
 	virtual ~GodotConstraint2D() {}
 };
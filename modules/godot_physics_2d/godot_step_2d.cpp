@@ -91,6 +91,19 @@ void GodotStep2D::_pre_solve_island(LocalVector<GodotConstraint2D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+void GodotStep2D::_pre_solve_island_indexed(uint32_t p_index, void *p_userdata) {
+	_pre_solve_island(constraint_islands[parallel_pre_solve_islands[p_index]]);
+}
+
+bool GodotStep2D::_is_island_pre_solve_thread_safe(const LocalVector<GodotConstraint2D *> &p_constraint_island) const {
+	for (const GodotConstraint2D *constraint : p_constraint_island) {
+		if (!constraint->is_pre_solve_thread_safe()) {
+			return false;
+		}
+	}
+	return true;
+}
+
 void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const {
 	const LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[p_island_index];
 
@@ -252,9 +265,27 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
+	if (p_space->is_parallel_pre_solve_enabled()) {
+		// Islands touching shared state (areas, contact debugging, static bodies reporting contacts)
+		// are pre-solved here, the others are independent and can be pre-solved on threads.
+		// Since islands don't share any data, the result is the same as pre-solving them all serially.
+		parallel_pre_solve_islands.clear();
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_index];
+			if (_is_island_pre_solve_thread_safe(constraint_island)) {
+				parallel_pre_solve_islands.push_back(island_index);
+			} else {
+				_pre_solve_island(constraint_island);
+			}
+		}
+
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_pre_solve_island_indexed, nullptr, parallel_pre_solve_islands.size(), -1, true, SNAME("Physics2DConstraintPreSolveIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_pre_solve_island(constraint_islands[island_index]);
+		}
 	}
 
 	/* SOLVE CONSTRAINT ISLANDS */
@@ -300,6 +331,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 GodotStep2D::GodotStep2D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
+	parallel_pre_solve_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
 }
 
@@ -130,8 +130,8 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
-void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
-	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+void GodotStep3D::_solve_island(uint32_t p_order_index, void *p_userdata) {
+	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_solve_order[p_order_index].island_index];
 
 	int current_priority = 1;
 
@@ -356,15 +356,26 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
 	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
+	island_solve_order.clear();
 	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
+		LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_index];
+		_pre_solve_island(constraint_island);
+		if (!constraint_island.is_empty()) {
+			// Islands left without constraints (e.g. area pairs) have nothing to solve.
+			island_solve_order.push_back({ island_index, constraint_island.size() });
+		}
 	}
 
+	// Islands are independent, so the order they're solved in doesn't change the result.
+	// Worker threads pick elements one by one, so dispatching the heaviest islands first
+	// keeps a single large island from being started last and stalling the whole step.
+	island_solve_order.sort();
+
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_solve_order.size(), -1, true, SNAME("Physics3DConstraintSolveIslands"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -411,6 +422,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
+	island_solve_order.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
 }
 
@@ -35,6 +35,19 @@
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
+	struct IslandSolveOrder {
+		uint32_t island_index = 0;
+		uint32_t constraint_count = 0;
+
+		// Largest islands first, so they start early and small ones fill the gaps.
+		_FORCE_INLINE_ bool operator<(const IslandSolveOrder &p_other) const {
+			if (constraint_count == p_other.constraint_count) {
+				return island_index < p_other.island_index;
+			}
+			return constraint_count > p_other.constraint_count;
+		}
+	};
+
 	uint64_t _step = 1;
 
 	int iterations = 0;
@@ -43,12 +56,13 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<IslandSolveOrder> island_solve_order;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
-	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _solve_island(uint32_t p_order_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
@@ -1329,6 +1329,8 @@ void GodotNavigationServer2D::physics_process(double p_delta_time) {
 	int _new_pm_edge_connection_count = 0;
 	int _new_pm_edge_free_count = 0;
 	int _new_pm_obstacle_count = 0;
+	uint64_t _new_pm_path_cache_hit_count = 0;
+	uint64_t _new_pm_path_cache_miss_count = 0;
 
 	MutexLock lock(operations_mutex);
 	for (uint32_t i(0); i < active_maps.size(); i++) {
@@ -1345,6 +1347,8 @@ void GodotNavigationServer2D::physics_process(double p_delta_time) {
 		_new_pm_edge_connection_count += active_maps[i]->get_pm_edge_connection_count();
 		_new_pm_edge_free_count += active_maps[i]->get_pm_edge_free_count();
 		_new_pm_obstacle_count += active_maps[i]->get_pm_obstacle_count();
+		_new_pm_path_cache_hit_count += active_maps[i]->get_path_cache_hit_count();
+		_new_pm_path_cache_miss_count += active_maps[i]->get_path_cache_miss_count();
 	}
 
 	pm_region_count = _new_pm_region_count;
@@ -1356,6 +1360,8 @@ void GodotNavigationServer2D::physics_process(double p_delta_time) {
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
 	pm_obstacle_count = _new_pm_obstacle_count;
+	pm_path_cache_hit_count = MIN(_new_pm_path_cache_hit_count, (uint64_t)INT32_MAX);
+	pm_path_cache_miss_count = MIN(_new_pm_path_cache_miss_count, (uint64_t)INT32_MAX);
 }
 
 void GodotNavigationServer2D::set_active(bool p_active) {
@@ -1430,6 +1436,12 @@ int GodotNavigationServer2D::get_process_info(ProcessInfo p_info) const {
 		case INFO_OBSTACLE_COUNT: {
 			return pm_obstacle_count;
 		} break;
+		case INFO_PATH_CACHE_HIT_COUNT: {
+			return pm_path_cache_hit_count;
+		} break;
+		case INFO_PATH_CACHE_MISS_COUNT: {
+			return pm_path_cache_miss_count;
+		} break;
 	}
 
 	return 0;
@@ -99,6 +99,8 @@ class GodotNavigationServer2D : public NavigationServer2D {
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
 	int pm_obstacle_count = 0;
+	int pm_path_cache_hit_count = 0;
+	int pm_path_cache_miss_count = 0;
 
 public:
 	GodotNavigationServer2D();
@@ -74,6 +74,8 @@ struct NavMapIteration2D {
 	mutable SafeNumeric<uint32_t> users;
 	RWLock rwlock;
 
+	uint32_t iteration_id = 0;
+
 	LocalVector<Ref<NavRegionIteration2D>> region_iterations;
 	LocalVector<Ref<NavLinkIteration2D>> link_iterations;
 
@@ -124,6 +124,77 @@ PointKey NavMap2D::get_point_key(const Vector2 &p_pos) const {
 	return p;
 }
 
+uint32_t NavMap2D::PathCacheKey::hash(const PathCacheKey &p_key) {
+	uint32_t h = hash_murmur3_one_32(p_key.start_cell.x);
+	h = hash_murmur3_one_32(p_key.start_cell.y, h);
+	h = hash_murmur3_one_32(p_key.target_cell.x, h);
+	h = hash_murmur3_one_32(p_key.target_cell.y, h);
+	h = hash_murmur3_one_32(p_key.navigation_layers, h);
+	h = hash_murmur3_one_64(p_key.metadata_flags, h);
+	h = hash_murmur3_one_32(p_key.pathfinding_algorithm, h);
+	h = hash_murmur3_one_32(p_key.path_postprocessing, h);
+	h = hash_murmur3_one_32(p_key.simplify_path, h);
+	h = hash_murmur3_one_real(p_key.simplify_epsilon, h);
+	h = hash_murmur3_one_float(p_key.path_return_max_length, h);
+	h = hash_murmur3_one_float(p_key.path_return_max_radius, h);
+	h = hash_murmur3_one_32(p_key.path_search_max_polygons, h);
+	h = hash_murmur3_one_float(p_key.path_search_max_distance, h);
+	for (const RID &region : p_key.excluded_regions) {
+		h = hash_murmur3_one_64(region.get_id(), h);
+	}
+	h = hash_murmur3_one_32(p_key.excluded_regions.size(), h);
+	for (const RID &region : p_key.included_regions) {
+		h = hash_murmur3_one_64(region.get_id(), h);
+	}
+	return hash_fmix32(h);
+}
+
+bool NavMap2D::PathCacheKey::operator==(const PathCacheKey &p_key) const {
+	if (start_cell != p_key.start_cell || target_cell != p_key.target_cell ||
+			navigation_layers != p_key.navigation_layers || metadata_flags != p_key.metadata_flags ||
+			pathfinding_algorithm != p_key.pathfinding_algorithm || path_postprocessing != p_key.path_postprocessing ||
+			simplify_path != p_key.simplify_path || simplify_epsilon != p_key.simplify_epsilon ||
+			path_return_max_length != p_key.path_return_max_length || path_return_max_radius != p_key.path_return_max_radius ||
+			path_search_max_polygons != p_key.path_search_max_polygons || path_search_max_distance != p_key.path_search_max_distance ||
+			excluded_regions.size() != p_key.excluded_regions.size() || included_regions.size() != p_key.included_regions.size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < excluded_regions.size(); i++) {
+		if (excluded_regions[i] != p_key.excluded_regions[i]) {
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < included_regions.size(); i++) {
+		if (included_regions[i] != p_key.included_regions[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+NavMap2D::PathCacheKey NavMap2D::_get_path_cache_key(const NavMeshQueries2D::NavMeshPathQueryTask2D &p_query_task) const {
+	PathCacheKey key;
+	key.start_cell = Vector2i((p_query_task.start_position / cell_size).floor());
+	key.target_cell = Vector2i((p_query_task.target_position / cell_size).floor());
+	key.navigation_layers = p_query_task.navigation_layers;
+	key.metadata_flags = p_query_task.metadata_flags;
+	key.pathfinding_algorithm = p_query_task.pathfinding_algorithm;
+	key.path_postprocessing = p_query_task.path_postprocessing;
+	key.simplify_path = p_query_task.simplify_path;
+	key.simplify_epsilon = p_query_task.simplify_epsilon;
+	key.path_return_max_length = p_query_task.path_return_max_length;
+	key.path_return_max_radius = p_query_task.path_return_max_radius;
+	key.path_search_max_polygons = p_query_task.path_search_max_polygons;
+	key.path_search_max_distance = p_query_task.path_search_max_distance;
+	if (p_query_task.exclude_regions) {
+		key.excluded_regions = p_query_task.excluded_regions;
+	}
+	if (p_query_task.include_regions) {
+		key.included_regions = p_query_task.included_regions;
+	}
+	return key;
+}
+
 void NavMap2D::query_path(NavMeshQueries2D::NavMeshPathQueryTask2D &p_query_task) {
 	if (iteration_id == 0) {
 		return;
@@ -131,6 +202,26 @@ void NavMap2D::query_path(NavMeshQueries2D::NavMeshPathQueryTask2D &p_query_task
 
 	GET_MAP_ITERATION();
 
+	PathCacheKey path_cache_key;
+	if (path_cache_size > 0) {
+		path_cache_key = _get_path_cache_key(p_query_task);
+
+		MutexLock lock(path_cache_mutex);
+		const PathCacheEntry *path_cache_entry = path_cache.getptr(path_cache_key);
+		// Entries of an older map iteration may still be stored by queries that were running during the sync.
+		if (path_cache_entry && path_cache_entry->iteration_id == map_iteration.iteration_id) {
+			p_query_task.path_points = path_cache_entry->path_points;
+			p_query_task.path_meta_point_types = path_cache_entry->path_meta_point_types;
+			p_query_task.path_meta_point_rids = path_cache_entry->path_meta_point_rids;
+			p_query_task.path_meta_point_owners = path_cache_entry->path_meta_point_owners;
+			p_query_task.path_length = path_cache_entry->path_length;
+			p_query_task.status = NavMeshQueries2D::NavMeshPathQueryTask2D::TaskStatus::QUERY_FINISHED;
+			path_cache_hit_count.increment();
+			return;
+		}
+		path_cache_miss_count.increment();
+	}
+
 	map_iteration.path_query_slots_semaphore.wait();
 
 	map_iteration.path_query_slots_mutex.lock();
@@ -157,6 +248,19 @@ void NavMap2D::query_path(NavMeshQueries2D::NavMeshPathQueryTask2D &p_query_task
 	map_iteration.path_query_slots_mutex.unlock();
 
 	map_iteration.path_query_slots_semaphore.post();
+
+	if (path_cache_size > 0 && p_query_task.status == NavMeshQueries2D::NavMeshPathQueryTask2D::TaskStatus::QUERY_FINISHED) {
+		PathCacheEntry path_cache_entry;
+		path_cache_entry.iteration_id = map_iteration.iteration_id;
+		path_cache_entry.path_points = p_query_task.path_points;
+		path_cache_entry.path_meta_point_types = p_query_task.path_meta_point_types;
+		path_cache_entry.path_meta_point_rids = p_query_task.path_meta_point_rids;
+		path_cache_entry.path_meta_point_owners = p_query_task.path_meta_point_owners;
+		path_cache_entry.path_length = p_query_task.path_length;
+
+		MutexLock lock(path_cache_mutex);
+		path_cache.insert(path_cache_key, path_cache_entry);
+	}
 }
 
 Vector2 NavMap2D::get_closest_point(const Vector2 &p_point) const {
@@ -364,9 +468,16 @@ void NavMap2D::_sync_iteration() {
 	// Finally ping-pong switch the iteration slot.
 	iteration_slot_rwlock.write_lock();
 	uint32_t next_iteration_slot_index = (iteration_slot_index + 1) % 2;
+	iteration_slots[next_iteration_slot_index].iteration_id = iteration_id;
 	iteration_slot_index = next_iteration_slot_index;
 	iteration_slot_rwlock.write_unlock();
 
+	// Cached paths were found on the previous iteration.
+	if (path_cache_size > 0) {
+		MutexLock lock(path_cache_mutex);
+		path_cache.clear();
+	}
+
 	iteration_ready = false;
 }
 
@@ -782,6 +893,11 @@ NavMap2D::NavMap2D() {
 #else
 	use_async_iterations = false;
 #endif
+
+	path_cache_size = MAX(0, int(GLOBAL_GET("navigation/2d/path_cache_size")));
+	if (path_cache_size > 0) {
+		path_cache.set_capacity(path_cache_size);
+	}
 }
 
 NavMap2D::~NavMap2D() {
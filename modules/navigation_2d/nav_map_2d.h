@@ -37,6 +37,9 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/lru.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/navigation_2d/navigation_constants_2d.h"
 
 #include <KdTree2d.h>
@@ -131,6 +134,45 @@ class NavMap2D : public NavRid2D {
 
 	bool use_async_iterations = true;
 
+	/// Path query results of the current map iteration. Queries with the same parameters and
+	/// with start and target positions inside the same map cells reuse the cached path.
+	struct PathCacheKey {
+		Vector2i start_cell;
+		Vector2i target_cell;
+		uint32_t navigation_layers = 0;
+		int64_t metadata_flags = 0;
+		int pathfinding_algorithm = 0;
+		int path_postprocessing = 0;
+		bool simplify_path = false;
+		real_t simplify_epsilon = 0.0;
+		float path_return_max_length = 0.0;
+		float path_return_max_radius = 0.0;
+		int path_search_max_polygons = 0;
+		float path_search_max_distance = 0.0;
+		LocalVector<RID> excluded_regions;
+		LocalVector<RID> included_regions;
+
+		static uint32_t hash(const PathCacheKey &p_key);
+		bool operator==(const PathCacheKey &p_key) const;
+	};
+
+	struct PathCacheEntry {
+		uint32_t iteration_id = 0;
+		LocalVector<Vector2> path_points;
+		LocalVector<int32_t> path_meta_point_types;
+		LocalVector<RID> path_meta_point_rids;
+		LocalVector<int64_t> path_meta_point_owners;
+		float path_length = 0.0;
+	};
+
+	uint32_t path_cache_size = 0;
+	LRUCache<PathCacheKey, PathCacheEntry, PathCacheKey> path_cache;
+	Mutex path_cache_mutex;
+	SafeNumeric<uint64_t> path_cache_hit_count;
+	SafeNumeric<uint64_t> path_cache_miss_count;
+
+	PathCacheKey _get_path_cache_key(const NavMeshQueries2D::NavMeshPathQueryTask2D &p_query_task) const;
+
 	uint32_t iteration_slot_index = 0;
 	LocalVector<NavMapIteration2D> iteration_slots;
 	mutable RWLock iteration_slot_rwlock;
@@ -231,6 +273,8 @@ public:
 	int get_pm_edge_connection_count() const { return performance_data.pm_edge_connection_count; }
 	int get_pm_edge_free_count() const { return performance_data.pm_edge_free_count; }
 	int get_pm_obstacle_count() const { return performance_data.pm_obstacle_count; }
+	uint64_t get_path_cache_hit_count() const { return path_cache_hit_count.get(); }
+	uint64_t get_path_cache_miss_count() const { return path_cache_miss_count.get(); }
 
 	int get_region_connections_count(NavRegion2D *p_region) const;
 	Vector2 get_region_connection_pathway_start(NavRegion2D *p_region, int p_connection_id) const;
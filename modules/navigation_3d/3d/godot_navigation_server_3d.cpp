@@ -1457,6 +1457,18 @@ void GodotNavigationServer3D::query_path(const Ref<NavigationPathQueryParameters
 	NavMeshQueries3D::map_query_path(map, p_query_parameters, p_query_result, p_callback);
 }
 
+void GodotNavigationServer3D::query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND(p_query_parameters.is_empty());
+
+	const Ref<NavigationPathQueryParameters3D> first_query_parameters = p_query_parameters[0];
+	ERR_FAIL_COND(first_query_parameters.is_null());
+
+	NavMap3D *map = map_owner.get_or_null(first_query_parameters->get_map());
+	ERR_FAIL_NULL(map);
+
+	NavMeshQueries3D::map_query_paths(map, p_query_parameters, p_query_results, p_callback);
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 	RWLockWrite write_lock(geometry_parser_rwlock);
 
@@ -37,6 +37,8 @@
 #include "nav_region_iteration_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/pair.h"
 
 using namespace Nav3D;
 
@@ -72,6 +74,8 @@ void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
 
 	_build_step_navlink_connections(r_build);
 
+	_build_step_polygon_clusters(r_build);
+
 	_build_update_map_iteration(r_build);
 }
 
@@ -394,6 +398,307 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder3D::_build_region_polygon_clusters(const NavRegionIteration3D &p_region, uint32_t p_cluster_size, NavRegionClusters3D &r_region_clusters) {
+	const LocalVector<Polygon> &polygons = p_region.navmesh_polygons;
+	const LocalVector<LocalVector<Connection>> &internal_connections = p_region.internal_connections;
+	const uint32_t polygon_count = polygons.size();
+
+	LocalVector<uint32_t> &polygon_clusters = r_region_clusters.polygon_clusters;
+	LocalVector<Vector3> &cluster_positions = r_region_clusters.cluster_positions;
+	polygon_clusters.resize(polygon_count);
+	cluster_positions.clear();
+	r_region_clusters.portal_clusters.clear();
+	r_region_clusters.portals.clear();
+
+	if (polygon_count == 0) {
+		return;
+	}
+
+	// Bucket the polygons in a grid on the two largest axes of the region bounds.
+	// The grid cells are sized to hold about the requested cluster size in polygons.
+	const AABB bounds = p_region.bounds;
+	const int axis_a = bounds.get_longest_axis_index();
+	int axis_b = (axis_a + 1) % 3;
+	if (bounds.size[(axis_a + 2) % 3] > bounds.size[axis_b]) {
+		axis_b = (axis_a + 2) % 3;
+	}
+
+	const uint32_t grid_cell_count = MAX(1u, polygon_count / MAX(1u, p_cluster_size));
+	const real_t grid_area = bounds.size[axis_a] * bounds.size[axis_b];
+	real_t grid_cell_size;
+	if (grid_area > CMP_EPSILON) {
+		grid_cell_size = Math::sqrt(grid_area / grid_cell_count);
+	} else {
+		grid_cell_size = MAX(bounds.size[axis_a] / grid_cell_count, (real_t)CMP_EPSILON);
+	}
+
+	LocalVector<Vector3> polygon_centers;
+	LocalVector<uint64_t> polygon_cells;
+	polygon_centers.resize(polygon_count);
+	polygon_cells.resize(polygon_count);
+
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		const Polygon &polygon = polygons[i];
+		Vector3 center;
+		for (const Vector3 &vertex : polygon.vertices) {
+			center += vertex;
+		}
+		if (!polygon.vertices.is_empty()) {
+			center /= polygon.vertices.size();
+		}
+		polygon_centers[i] = center;
+
+		const int32_t cell_a = static_cast<int32_t>(Math::floor((center[axis_a] - bounds.position[axis_a]) / grid_cell_size));
+		const int32_t cell_b = static_cast<int32_t>(Math::floor((center[axis_b] - bounds.position[axis_b]) / grid_cell_size));
+		polygon_cells[i] = (uint64_t(uint32_t(cell_a)) << 32) | uint32_t(cell_b);
+		polygon_clusters[i] = UINT32_MAX;
+	}
+
+	// Split the grid cells into clusters of polygons that are connected inside the cell,
+	// so that a cluster never claims a connection that only exists through other cells.
+	LocalVector<uint32_t> polygon_stack;
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		if (polygon_clusters[i] != UINT32_MAX) {
+			continue;
+		}
+
+		const uint32_t cluster = cluster_positions.size();
+		Vector3 cluster_center_sum;
+		uint32_t cluster_polygon_count = 0;
+
+		polygon_clusters[i] = cluster;
+		polygon_stack.push_back(i);
+
+		while (!polygon_stack.is_empty()) {
+			const uint32_t polygon_index = polygon_stack[polygon_stack.size() - 1];
+			polygon_stack.remove_at(polygon_stack.size() - 1);
+
+			cluster_center_sum += polygon_centers[polygon_index];
+			cluster_polygon_count++;
+
+			if (polygon_index >= internal_connections.size()) {
+				continue;
+			}
+			for (const Connection &connection : internal_connections[polygon_index]) {
+				const uint32_t neighbor_index = connection.polygon->id;
+				if (polygon_clusters[neighbor_index] == UINT32_MAX && polygon_cells[neighbor_index] == polygon_cells[i]) {
+					polygon_clusters[neighbor_index] = cluster;
+					polygon_stack.push_back(neighbor_index);
+				}
+			}
+		}
+
+		cluster_positions.push_back(cluster_center_sum / cluster_polygon_count);
+	}
+
+	// Merge the polygon edges shared by two clusters into a single portal.
+	HashMap<uint64_t, uint32_t> portal_indices;
+	LocalVector<uint32_t> portal_edge_counts;
+
+	for (uint32_t i = 0; i < internal_connections.size(); i++) {
+		const uint32_t from_cluster = polygon_clusters[i];
+		for (const Connection &connection : internal_connections[i]) {
+			const uint32_t to_cluster = polygon_clusters[connection.polygon->id];
+			if (from_cluster == to_cluster) {
+				continue;
+			}
+
+			const uint64_t portal_key = (uint64_t(from_cluster) << 32) | to_cluster;
+			const Vector3 edge_center = (connection.pathway_start + connection.pathway_end) * 0.5;
+
+			HashMap<uint64_t, uint32_t>::Iterator portal_it = portal_indices.find(portal_key);
+			if (portal_it) {
+				r_region_clusters.portals[portal_it->value].position += edge_center;
+				portal_edge_counts[portal_it->value] += 1;
+			} else {
+				portal_indices.insert(portal_key, r_region_clusters.portals.size());
+				ClusterPortal portal;
+				portal.cluster = to_cluster;
+				portal.position = edge_center;
+				r_region_clusters.portal_clusters.push_back(from_cluster);
+				r_region_clusters.portals.push_back(portal);
+				portal_edge_counts.push_back(1);
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < r_region_clusters.portals.size(); i++) {
+		r_region_clusters.portals[i].position /= portal_edge_counts[i];
+	}
+}
+
+void NavMapBuilder3D::_build_step_polygon_clusters(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	HashMap<const NavRegionIteration3D *, NavRegionClusters3D> &region_clusters_cache = r_build.region_clusters_cache;
+
+	LocalVector<uint32_t> &polygon_clusters = map_iteration->polygon_clusters;
+	LocalVector<PolygonCluster> &clusters = map_iteration->clusters;
+	LocalVector<uint32_t> &cluster_portal_offsets = map_iteration->cluster_portal_offsets;
+	LocalVector<ClusterPortal> &cluster_portals = map_iteration->cluster_portals;
+
+	polygon_clusters.clear();
+	clusters.clear();
+	cluster_portal_offsets.clear();
+	cluster_portals.clear();
+
+	if (!r_build.use_hierarchical_path_search) {
+		region_clusters_cache.clear();
+		return;
+	}
+
+	const LocalVector<Ref<NavRegionIteration3D>> &regions = map_iteration->region_iterations;
+
+	// Forget the clusters of region iterations that are no longer part of the map.
+	// Unchanged regions keep their iteration and reuse the clusters of the last build.
+	HashSet<const NavRegionIteration3D *> map_regions;
+	for (const Ref<NavRegionIteration3D> &region : regions) {
+		map_regions.insert(region.ptr());
+	}
+	LocalVector<const NavRegionIteration3D *> stale_regions;
+	for (const KeyValue<const NavRegionIteration3D *, NavRegionClusters3D> &E : region_clusters_cache) {
+		if (!map_regions.has(E.key)) {
+			stale_regions.push_back(E.key);
+		}
+	}
+	for (const NavRegionIteration3D *stale_region : stale_regions) {
+		region_clusters_cache.erase(stale_region);
+	}
+
+	polygon_clusters.resize(r_build.polygon_count);
+
+	// First polygon id and polygon count of every navbase.
+	HashMap<const NavBaseIteration3D *, Pair<uint32_t, uint32_t>> navbase_polygon_ranges;
+
+	LocalVector<uint32_t> portal_clusters;
+	LocalVector<ClusterPortal> portals;
+
+	uint32_t polygon_offset = 0;
+
+	for (const Ref<NavRegionIteration3D> &region : regions) {
+		HashMap<const NavRegionIteration3D *, NavRegionClusters3D>::Iterator region_clusters_it = region_clusters_cache.find(region.ptr());
+		if (!region_clusters_it) {
+			region_clusters_it = region_clusters_cache.insert(region.ptr(), NavRegionClusters3D());
+			region_clusters_it->value.region_iteration = region;
+			_build_region_polygon_clusters(*region.ptr(), r_build.hierarchical_path_search_cluster_size, region_clusters_it->value);
+		}
+		const NavRegionClusters3D &region_clusters = region_clusters_it->value;
+
+		const uint32_t cluster_offset = clusters.size();
+		for (const Vector3 &cluster_position : region_clusters.cluster_positions) {
+			PolygonCluster cluster;
+			cluster.owner = region.ptr();
+			cluster.position = cluster_position;
+			clusters.push_back(cluster);
+		}
+
+		const uint32_t region_polygon_count = region_clusters.polygon_clusters.size();
+		for (uint32_t i = 0; i < region_polygon_count; i++) {
+			polygon_clusters[polygon_offset + i] = cluster_offset + region_clusters.polygon_clusters[i];
+		}
+
+		for (uint32_t i = 0; i < region_clusters.portals.size(); i++) {
+			ClusterPortal portal = region_clusters.portals[i];
+			portal.cluster += cluster_offset;
+			portal_clusters.push_back(cluster_offset + region_clusters.portal_clusters[i]);
+			portals.push_back(portal);
+		}
+
+		navbase_polygon_ranges[region.ptr()] = Pair<uint32_t, uint32_t>(polygon_offset, region_polygon_count);
+		polygon_offset += region_polygon_count;
+	}
+
+	// Every navigation link polygon is a cluster of its own.
+	for (const Polygon &link_polygon : map_iteration->navlink_polygons) {
+		PolygonCluster cluster;
+		cluster.owner = link_polygon.owner;
+		for (const Vector3 &vertex : link_polygon.vertices) {
+			cluster.position += vertex;
+		}
+		if (!link_polygon.vertices.is_empty()) {
+			cluster.position /= link_polygon.vertices.size();
+		}
+
+		polygon_clusters[polygon_offset] = clusters.size();
+		clusters.push_back(cluster);
+
+		navbase_polygon_ranges[link_polygon.owner] = Pair<uint32_t, uint32_t>(polygon_offset, 1);
+		polygon_offset += 1;
+	}
+
+	DEV_ASSERT(polygon_offset == polygon_clusters.size());
+
+	// Add the portals of the connections between regions and of the navigation links.
+	HashMap<uint64_t, uint32_t> external_portal_indices;
+	LocalVector<uint32_t> external_portal_edge_counts;
+	const uint32_t external_portals_begin = portals.size();
+
+	for (const KeyValue<const NavBaseIteration3D *, LocalVector<LocalVector<Connection>>> &E : map_iteration->navbases_polygons_external_connections) {
+		const Pair<uint32_t, uint32_t> *from_range = navbase_polygon_ranges.getptr(E.key);
+		if (!from_range) {
+			continue;
+		}
+
+		const uint32_t from_polygon_count = MIN(from_range->second, E.value.size());
+		for (uint32_t polygon_id = 0; polygon_id < from_polygon_count; polygon_id++) {
+			const uint32_t from_cluster = polygon_clusters[from_range->first + polygon_id];
+
+			for (const Connection &connection : E.value[polygon_id]) {
+				const Pair<uint32_t, uint32_t> *to_range = navbase_polygon_ranges.getptr(connection.polygon->owner);
+				if (!to_range || connection.polygon->id >= to_range->second) {
+					continue;
+				}
+				const uint32_t to_cluster = polygon_clusters[to_range->first + connection.polygon->id];
+				if (from_cluster == to_cluster) {
+					continue;
+				}
+
+				const uint64_t portal_key = (uint64_t(from_cluster) << 32) | to_cluster;
+				const Vector3 edge_center = (connection.pathway_start + connection.pathway_end) * 0.5;
+
+				HashMap<uint64_t, uint32_t>::Iterator portal_it = external_portal_indices.find(portal_key);
+				if (portal_it) {
+					portals[portal_it->value].position += edge_center;
+					external_portal_edge_counts[portal_it->value - external_portals_begin] += 1;
+				} else {
+					external_portal_indices.insert(portal_key, portals.size());
+					ClusterPortal portal;
+					portal.cluster = to_cluster;
+					portal.position = edge_center;
+					portal_clusters.push_back(from_cluster);
+					portals.push_back(portal);
+					external_portal_edge_counts.push_back(1);
+				}
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < external_portal_edge_counts.size(); i++) {
+		portals[external_portals_begin + i].position /= external_portal_edge_counts[i];
+	}
+
+	// Group the portals by the cluster they start from.
+	const uint32_t cluster_count = clusters.size();
+	cluster_portal_offsets.resize_initialized(cluster_count + 1);
+	for (uint32_t portal_cluster : portal_clusters) {
+		cluster_portal_offsets[portal_cluster + 1] += 1;
+	}
+	for (uint32_t i = 0; i < cluster_count; i++) {
+		cluster_portal_offsets[i + 1] += cluster_portal_offsets[i];
+	}
+
+	LocalVector<uint32_t> portal_write_indices;
+	portal_write_indices.resize(cluster_count);
+	for (uint32_t i = 0; i < cluster_count; i++) {
+		portal_write_indices[i] = cluster_portal_offsets[i];
+	}
+
+	cluster_portals.resize(portals.size());
+	for (uint32_t i = 0; i < portals.size(); i++) {
+		cluster_portals[portal_write_indices[portal_clusters[i]]++] = portals[i];
+	}
+}
+
 void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_build) {
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
 
@@ -427,6 +732,12 @@ void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_buil
 		}
 
 		DEV_ASSERT(p_path_query_slot.path_corridor.size() == p_path_query_slot.poly_to_id.size());
+
+		p_path_query_slot.traversable_clusters.clear();
+		p_path_query_slot.cluster_corridor.clear();
+		p_path_query_slot.cluster_corridor.resize(map_iteration->clusters.size());
+		p_path_query_slot.clusters_in_corridor.clear();
+		p_path_query_slot.clusters_in_corridor.resize_initialized(map_iteration->clusters.size());
 	}
 
 	map_iteration->path_query_slots_mutex.unlock();
@@ -32,7 +32,9 @@
 
 #include "../nav_utils_3d.h"
 
+class NavRegionIteration3D;
 struct NavMapIterationBuild3D;
+struct NavRegionClusters3D;
 
 class NavMapBuilder3D {
 	static void _build_step_gather_region_polygons(NavMapIterationBuild3D &r_build);
@@ -40,6 +42,8 @@ class NavMapBuilder3D {
 	static void _build_step_merge_edge_connection_pairs(NavMapIterationBuild3D &r_build);
 	static void _build_step_edge_connection_margin_connections(NavMapIterationBuild3D &r_build);
 	static void _build_step_navlink_connections(NavMapIterationBuild3D &r_build);
+	static void _build_step_polygon_clusters(NavMapIterationBuild3D &r_build);
+	static void _build_region_polygon_clusters(const NavRegionIteration3D &p_region, uint32_t p_cluster_size, NavRegionClusters3D &r_region_clusters);
 	static void _build_update_map_iteration(NavMapIterationBuild3D &r_build);
 
 public:
@@ -42,11 +42,24 @@ class NavRegion3D;
 class NavRegionIteration3D;
 struct NavMapIteration3D;
 
+struct NavRegionClusters3D {
+	Ref<NavRegionIteration3D> region_iteration; // Keeps the region iteration used as cache key alive.
+
+	LocalVector<uint32_t> polygon_clusters; // Local cluster of each region polygon.
+	LocalVector<Vector3> cluster_positions;
+
+	// Portals between the local clusters and the local cluster each portal starts from.
+	LocalVector<uint32_t> portal_clusters;
+	LocalVector<Nav3D::ClusterPortal> portals;
+};
+
 struct NavMapIterationBuild3D {
 	Vector3 merge_rasterizer_cell_size;
 	bool use_edge_connections = true;
 	real_t edge_connection_margin;
 	real_t link_connection_radius;
+	bool use_hierarchical_path_search = false;
+	uint32_t hierarchical_path_search_cluster_size = 128;
 	Nav3D::PerformanceData performance_data;
 	int polygon_count = 0;
 	int free_edge_count = 0;
@@ -54,6 +67,9 @@ struct NavMapIterationBuild3D {
 	HashMap<Nav3D::EdgeKey, Nav3D::EdgeConnectionPair, Nav3D::EdgeKey> iter_connection_pairs_map;
 	LocalVector<Nav3D::Connection> iter_free_edges;
 
+	// Kept between builds so that only new region iterations need to be clustered.
+	HashMap<const NavRegionIteration3D *, NavRegionClusters3D> region_clusters_cache;
+
 	NavMapIteration3D *map_iteration = nullptr;
 
 	int navmesh_polygon_count = 0;
@@ -89,6 +105,13 @@ struct NavMapIteration3D {
 
 	HashMap<NavRegion3D *, Ref<NavRegionIteration3D>> region_ptr_to_region_iteration;
 
+	// Coarse graph over clusters of neighboring polygons used by hierarchical path searches.
+	// Empty when hierarchical path search is disabled.
+	LocalVector<uint32_t> polygon_clusters; // Cluster of each polygon, indexed like the path query slot polygon ids.
+	LocalVector<Nav3D::PolygonCluster> clusters;
+	LocalVector<uint32_t> cluster_portal_offsets; // Range of each cluster in cluster_portals.
+	LocalVector<Nav3D::ClusterPortal> cluster_portals;
+
 	LocalVector<NavMeshQueries3D::PathQuerySlot> path_query_slots;
 	Mutex path_query_slots_mutex;
 	Semaphore path_query_slots_semaphore;
@@ -103,6 +126,10 @@ struct NavMapIteration3D {
 		navbases_polygons_external_connections.clear();
 		navlink_polygons.clear();
 		region_ptr_to_region_iteration.clear();
+		polygon_clusters.clear();
+		clusters.clear();
+		cluster_portal_offsets.clear();
+		cluster_portals.clear();
 	}
 };
 
@@ -145,18 +145,12 @@ void NavMeshQueries3D::_query_task_push_back_point_with_metadata(NavMeshPathQuer
 	p_query_task.path_points.push_back(p_point);
 }
 
-void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
-	ERR_FAIL_NULL(map);
-	ERR_FAIL_COND(p_query_parameters.is_null());
-	ERR_FAIL_COND(p_query_result.is_null());
-
+void NavMeshQueries3D::_query_task_set_parameters(NavMeshPathQueryTask3D &p_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters) {
 	using namespace NavigationDefaults3D;
 
-	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
-	query_task.start_position = p_query_parameters->get_start_position();
-	query_task.target_position = p_query_parameters->get_target_position();
-	query_task.navigation_layers = p_query_parameters->get_navigation_layers();
-	query_task.callback = p_callback;
+	p_query_task.start_position = p_query_parameters->get_start_position();
+	p_query_task.target_position = p_query_parameters->get_target_position();
+	p_query_task.navigation_layers = p_query_parameters->get_navigation_layers();
 
 	const TypedArray<RID> &_excluded_regions = p_query_parameters->get_excluded_regions();
 	const TypedArray<RID> &_included_regions = p_query_parameters->get_included_regions();
@@ -164,66 +158,80 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	uint32_t _excluded_region_count = _excluded_regions.size();
 	uint32_t _included_region_count = _included_regions.size();
 
-	query_task.exclude_regions = _excluded_region_count > 0;
-	query_task.include_regions = _included_region_count > 0;
+	p_query_task.exclude_regions = _excluded_region_count > 0;
+	p_query_task.include_regions = _included_region_count > 0;
 
-	if (query_task.exclude_regions) {
-		query_task.excluded_regions.resize(_excluded_region_count);
+	if (p_query_task.exclude_regions) {
+		p_query_task.excluded_regions.resize(_excluded_region_count);
 		for (uint32_t i = 0; i < _excluded_region_count; i++) {
-			query_task.excluded_regions[i] = _excluded_regions[i];
+			p_query_task.excluded_regions[i] = _excluded_regions[i];
 		}
 	}
 
-	if (query_task.include_regions) {
-		query_task.included_regions.resize(_included_region_count);
+	if (p_query_task.include_regions) {
+		p_query_task.included_regions.resize(_included_region_count);
 		for (uint32_t i = 0; i < _included_region_count; i++) {
-			query_task.included_regions[i] = _included_regions[i];
+			p_query_task.included_regions[i] = _included_regions[i];
 		}
 	}
 
 	switch (p_query_parameters->get_pathfinding_algorithm()) {
 		case NavigationPathQueryParameters3D::PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR: {
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			p_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathfindingAlgorithm - fallback to default");
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			p_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 	}
 
 	switch (p_query_parameters->get_path_postprocessing()) {
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			p_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
+			p_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_NONE: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
+			p_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathPostProcessing - fallback to default");
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			p_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 	}
 
-	query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
-	query_task.simplify_path = p_query_parameters->get_simplify_path();
-	query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
-	query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
-	query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
-	query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
-	query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
-	query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+	p_query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
+	p_query_task.simplify_path = p_query_parameters->get_simplify_path();
+	p_query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
+	p_query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
+	p_query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
+	p_query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
+	p_query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
+	p_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+}
+
+void NavMeshQueries3D::_query_task_set_result(const NavMeshPathQueryTask3D &p_query_task, Ref<NavigationPathQueryResult3D> p_query_result) {
+	p_query_result->set_data(
+			p_query_task.path_points,
+			p_query_task.path_meta_point_types,
+			p_query_task.path_meta_point_rids,
+			p_query_task.path_meta_point_owners);
+	p_query_result->set_path_length(p_query_task.path_length);
+}
+
+void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
+	ERR_FAIL_NULL(map);
+	ERR_FAIL_COND(p_query_parameters.is_null());
+	ERR_FAIL_COND(p_query_result.is_null());
+
+	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
+	_query_task_set_parameters(query_task, p_query_parameters);
+	query_task.callback = p_callback;
 
 	map->query_path(query_task);
 
-	p_query_result->set_data(
-			query_task.path_points,
-			query_task.path_meta_point_types,
-			query_task.path_meta_point_rids,
-			query_task.path_meta_point_owners);
-	p_query_result->set_path_length(query_task.path_length);
+	_query_task_set_result(query_task, p_query_result);
 
 	if (query_task.callback.is_valid()) {
 		if (emit_callback(query_task.callback)) {
@@ -234,6 +242,144 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	}
 }
 
+void NavMeshQueries3D::map_query_paths(NavMap3D *map, const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_NULL(map);
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The number of path query parameters and results must match.");
+
+	const uint32_t query_count = p_query_parameters.size();
+
+	PathQueryBatch3D *batch = memnew(PathQueryBatch3D);
+	batch->query_tasks.resize(query_count);
+	batch->callback = p_callback;
+
+	for (uint32_t i = 0; i < query_count; i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		if (query_parameters.is_null() || query_result.is_null() || query_parameters->get_map() != map->get_self()) {
+			memdelete(batch);
+			ERR_FAIL_MSG(vformat("Invalid path query at index %d. All queries of a batch need parameters and a result, and must use the same map.", i));
+		}
+
+		NavMeshPathQueryTask3D &query_task = batch->query_tasks[i];
+		_query_task_set_parameters(query_task, query_parameters);
+		query_task.query_result = query_result;
+	}
+
+	map->query_paths(batch);
+}
+
+bool NavMeshQueries3D::_query_tasks_have_same_filters(const NavMeshPathQueryTask3D &p_query_task_a, const NavMeshPathQueryTask3D &p_query_task_b) {
+	if (p_query_task_a.navigation_layers != p_query_task_b.navigation_layers || p_query_task_a.exclude_regions != p_query_task_b.exclude_regions || p_query_task_a.include_regions != p_query_task_b.include_regions) {
+		return false;
+	}
+	if (p_query_task_a.excluded_regions.size() != p_query_task_b.excluded_regions.size() || p_query_task_a.included_regions.size() != p_query_task_b.included_regions.size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < p_query_task_a.excluded_regions.size(); i++) {
+		if (p_query_task_a.excluded_regions[i] != p_query_task_b.excluded_regions[i]) {
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < p_query_task_a.included_regions.size(); i++) {
+		if (p_query_task_a.included_regions[i] != p_query_task_b.included_regions[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void NavMeshQueries3D::query_batch_prepare_position_lookups(PathQueryBatch3D &p_batch) {
+	// Index of the first query task of each filter group, and the lookups of positions in that group.
+	LocalVector<uint32_t> filter_query_tasks;
+	LocalVector<HashMap<Vector3, uint32_t>> filter_position_lookups;
+
+	p_batch.position_lookups.clear();
+	p_batch.query_task_position_lookups.resize(p_batch.query_tasks.size() * 2);
+
+	for (uint32_t i = 0; i < p_batch.query_tasks.size(); i++) {
+		const NavMeshPathQueryTask3D &query_task = p_batch.query_tasks[i];
+
+		uint32_t filter_index = 0;
+		while (filter_index < filter_query_tasks.size() && !_query_tasks_have_same_filters(p_batch.query_tasks[filter_query_tasks[filter_index]], query_task)) {
+			filter_index++;
+		}
+		if (filter_index == filter_query_tasks.size()) {
+			filter_query_tasks.push_back(i);
+			filter_position_lookups.push_back(HashMap<Vector3, uint32_t>());
+		}
+
+		const Vector3 positions[2] = { query_task.start_position, query_task.target_position };
+		for (uint32_t j = 0; j < 2; j++) {
+			HashMap<Vector3, uint32_t> &position_lookups = filter_position_lookups[filter_index];
+			HashMap<Vector3, uint32_t>::Iterator E = position_lookups.find(positions[j]);
+			if (!E) {
+				PathQueryBatch3D::PositionLookup lookup;
+				lookup.filter_query_task = filter_query_tasks[filter_index];
+				lookup.position = positions[j];
+				E = position_lookups.insert(positions[j], p_batch.position_lookups.size());
+				p_batch.position_lookups.push_back(lookup);
+			}
+			p_batch.query_task_position_lookups[i * 2 + j] = E->value;
+		}
+	}
+}
+
+void NavMeshQueries3D::query_batch_map_iteration_lookup_position(PathQueryBatch3D &p_batch, uint32_t p_lookup_index, const NavMapIteration3D &p_map_iteration) {
+	PathQueryBatch3D::PositionLookup &lookup = p_batch.position_lookups[p_lookup_index];
+	const NavMeshPathQueryTask3D &filter_query_task = p_batch.query_tasks[lookup.filter_query_task];
+
+	real_t closest_distance = FLT_MAX;
+
+	for (const Ref<NavRegionIteration3D> &region : p_map_iteration.region_iterations) {
+		if (!_query_task_is_connection_owner_usable(filter_query_task, region.ptr())) {
+			continue;
+		}
+
+		for (const Polygon &p : region->get_navmesh_polygons()) {
+			// Only consider the polygon if it in a region with compatible layers.
+			if ((filter_query_task.navigation_layers & p.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			for (uint32_t point_id = 2; point_id < p.vertices.size(); point_id++) {
+				const Face3 face(p.vertices[0], p.vertices[point_id - 1], p.vertices[point_id]);
+
+				const Vector3 point = face.get_closest_point_to(lookup.position);
+				const real_t distance_to_point = point.distance_to(lookup.position);
+				if (distance_to_point < closest_distance) {
+					closest_distance = distance_to_point;
+					lookup.polygon = &p;
+					lookup.closest_position = point;
+				}
+			}
+		}
+	}
+}
+
+void NavMeshQueries3D::query_batch_apply_position_lookups(PathQueryBatch3D &p_batch) {
+	for (uint32_t i = 0; i < p_batch.query_tasks.size(); i++) {
+		NavMeshPathQueryTask3D &query_task = p_batch.query_tasks[i];
+		const PathQueryBatch3D::PositionLookup &begin = p_batch.position_lookups[p_batch.query_task_position_lookups[i * 2]];
+		const PathQueryBatch3D::PositionLookup &end = p_batch.position_lookups[p_batch.query_task_position_lookups[i * 2 + 1]];
+
+		query_task.begin_polygon = begin.polygon;
+		query_task.begin_position = begin.closest_position;
+		query_task.end_polygon = end.polygon;
+		query_task.end_position = end.closest_position;
+		query_task.start_end_positions_resolved = true;
+	}
+}
+
+void NavMeshQueries3D::query_batch_dispatch_results(PathQueryBatch3D &p_batch) {
+	for (NavMeshPathQueryTask3D &query_task : p_batch.query_tasks) {
+		_query_task_set_result(query_task, query_task.query_result);
+	}
+
+	if (p_batch.callback.is_valid()) {
+		emit_callback(p_batch.callback);
+	}
+}
+
 void NavMeshQueries3D::_query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
@@ -293,8 +439,14 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	Vector3 new_entry = Geometry3D::get_closest_point_to_segment(p_least_cost_poly.entry, p_connection.pathway_start, p_connection.pathway_end);
 	real_t new_traveled_distance = p_least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost + p_poly_enter_cost + p_least_cost_poly.traveled_distance;
 
+	const uint32_t neighbor_poly_id = p_query_task.path_query_slot->poly_to_id[p_connection.polygon];
+	if (p_query_task.polygon_clusters && !p_query_task.path_query_slot->clusters_in_corridor[(*p_query_task.polygon_clusters)[neighbor_poly_id]]) {
+		// Outside of the corridor found by the hierarchical search.
+		return;
+	}
+
 	// Check if the neighbor polygon has already been processed.
-	NavigationPoly &neighbor_poly = navigation_polys[p_query_task.path_query_slot->poly_to_id[p_connection.polygon]];
+	NavigationPoly &neighbor_poly = navigation_polys[neighbor_poly_id];
 	if (new_traveled_distance < neighbor_poly.traveled_distance) {
 		// Add the polygon to the heap of polygons to traverse next.
 		neighbor_poly.back_navigation_poly_id = p_least_cost_id;
@@ -316,6 +468,98 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	}
 }
 
+bool NavMeshQueries3D::_query_task_build_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
+	const LocalVector<uint32_t> &polygon_clusters = p_map_iteration.polygon_clusters;
+	const LocalVector<PolygonCluster> &clusters = p_map_iteration.clusters;
+	if (clusters.is_empty()) {
+		return false;
+	}
+
+	PathQuerySlot *path_query_slot = p_query_task.path_query_slot;
+	const uint32_t begin_cluster = polygon_clusters[path_query_slot->poly_to_id[p_query_task.begin_polygon]];
+	const uint32_t end_cluster = polygon_clusters[path_query_slot->poly_to_id[p_query_task.end_polygon]];
+	if (begin_cluster == end_cluster) {
+		return false;
+	}
+
+	const Vector3 &end_point = p_query_task.end_position;
+
+	Heap<NavigationCluster *, NavClusterTravelCostGreaterThan, NavClusterHeapIndexer> &traversable_clusters = path_query_slot->traversable_clusters;
+	traversable_clusters.clear();
+
+	LocalVector<NavigationCluster> &navigation_clusters = path_query_slot->cluster_corridor;
+	for (NavigationCluster &navigation_cluster : navigation_clusters) {
+		navigation_cluster.reset();
+	}
+
+	NavigationCluster &begin_navigation_cluster = navigation_clusters[begin_cluster];
+	begin_navigation_cluster.cluster = begin_cluster;
+	begin_navigation_cluster.entry = p_query_task.begin_position;
+	begin_navigation_cluster.traveled_distance = 0.0;
+
+	// A* over the cluster graph, with the same travel and enter costs as the polygon search.
+	uint32_t least_cost_cluster = begin_cluster;
+	bool found_route = false;
+
+	while (true) {
+		const NavigationCluster &least_cost_navigation_cluster = navigation_clusters[least_cost_cluster];
+		const NavBaseIteration3D *least_cost_owner = clusters[least_cost_cluster].owner;
+		const real_t travel_cost = least_cost_owner->get_travel_cost();
+
+		for (uint32_t portal_index = p_map_iteration.cluster_portal_offsets[least_cost_cluster]; portal_index < p_map_iteration.cluster_portal_offsets[least_cost_cluster + 1]; portal_index++) {
+			const ClusterPortal &portal = p_map_iteration.cluster_portals[portal_index];
+			const NavBaseIteration3D *portal_owner = clusters[portal.cluster].owner;
+			if (!_query_task_is_connection_owner_usable(p_query_task, portal_owner)) {
+				continue;
+			}
+
+			real_t new_traveled_distance = least_cost_navigation_cluster.traveled_distance + least_cost_navigation_cluster.entry.distance_to(portal.position) * travel_cost;
+			if (portal_owner != least_cost_owner) {
+				new_traveled_distance += portal_owner->get_enter_cost();
+			}
+
+			NavigationCluster &neighbor_cluster = navigation_clusters[portal.cluster];
+			if (new_traveled_distance < neighbor_cluster.traveled_distance) {
+				neighbor_cluster.back_cluster = least_cost_cluster;
+				neighbor_cluster.traveled_distance = new_traveled_distance;
+				neighbor_cluster.distance_to_destination = portal.position.distance_to(end_point) * portal_owner->get_travel_cost();
+				neighbor_cluster.entry = portal.position;
+
+				if (neighbor_cluster.traversable_cluster_index != traversable_clusters.INVALID_INDEX) {
+					traversable_clusters.shift(neighbor_cluster.traversable_cluster_index);
+				} else {
+					neighbor_cluster.cluster = portal.cluster;
+					traversable_clusters.push(&neighbor_cluster);
+				}
+			}
+		}
+
+		if (traversable_clusters.is_empty()) {
+			break;
+		}
+
+		least_cost_cluster = traversable_clusters.pop()->cluster;
+		if (least_cost_cluster == end_cluster) {
+			found_route = true;
+			break;
+		}
+	}
+
+	if (!found_route) {
+		// Leave unreachable targets to the polygon search, it also finds the closest reachable polygon.
+		return false;
+	}
+
+	LocalVector<uint8_t> &clusters_in_corridor = path_query_slot->clusters_in_corridor;
+	memset(clusters_in_corridor.ptr(), 0, clusters_in_corridor.size());
+	for (uint32_t cluster = end_cluster; cluster != UINT32_MAX; cluster = navigation_clusters[cluster].back_cluster) {
+		clusters_in_corridor[cluster] = 1;
+	}
+
+	p_query_task.polygon_clusters = &polygon_clusters;
+	return true;
+}
+
 void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	const Vector3 p_target_position = p_query_task.target_position;
 	const Polygon *begin_poly = p_query_task.begin_polygon;
@@ -342,7 +586,8 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 	begin_navigation_poly.traveled_distance = 0.f;
 
 	// This is an implementation of the A* algorithm.
-	uint32_t least_cost_id = p_query_task.path_query_slot->poly_to_id[begin_poly];
+	const uint32_t begin_poly_id = p_query_task.path_query_slot->poly_to_id[begin_poly];
+	uint32_t least_cost_id = begin_poly_id;
 	bool found_route = false;
 
 	const Polygon *reachable_end = nullptr;
@@ -363,6 +608,9 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 
 	bool has_path_search_max = p_query_task.path_search_max_polygons > 0 || path_search_max_distance_sqr > 0.0;
 
+	// With hierarchical path search only the polygons of the clusters along the coarse route are searched.
+	bool use_cluster_corridor = _query_task_build_cluster_corridor(p_query_task, p_map_iteration);
+
 	while (true) {
 		const NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 
@@ -397,6 +645,27 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 		}
 
 		poly_enter_cost = 0;
+
+		if (traversable_polys.is_empty() && use_cluster_corridor && !path_search_max_reached) {
+			// The end polygon can not be reached inside the cluster corridor, search the whole map instead.
+			use_cluster_corridor = false;
+			p_query_task.polygon_clusters = nullptr;
+
+			for (NavigationPoly &nav_poly : navigation_polys) {
+				nav_poly.reset();
+			}
+			navigation_polys[begin_poly_id].poly = begin_poly;
+			navigation_polys[begin_poly_id].entry = begin_point;
+			navigation_polys[begin_poly_id].back_navigation_edge_pathway_start = begin_point;
+			navigation_polys[begin_poly_id].back_navigation_edge_pathway_end = begin_point;
+			navigation_polys[begin_poly_id].traveled_distance = 0.f;
+			least_cost_id = begin_poly_id;
+			reachable_end = nullptr;
+			distance_to_reachable_end = FLT_MAX;
+			processed_polygon_count = 0;
+			continue;
+		}
+
 		// When the heap of traversable polygons is empty at this point it means the end polygon is
 		// unreachable.
 		if (traversable_polys.is_empty()) {
@@ -481,6 +750,8 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 		}
 	}
 
+	p_query_task.polygon_clusters = nullptr;
+
 	// We did not find a route but we have both a start polygon and an end polygon at this point.
 	// Usually this happens because there was not a single external or internal connected edge, e.g. our start polygon is an isolated, single convex polygon.
 	if (!found_route) {
@@ -514,7 +785,9 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	p_query_task.path_clear();
 
-	_query_task_find_start_end_positions(p_query_task, p_map_iteration);
+	if (!p_query_task.start_end_positions_resolved) {
+		_query_task_find_start_end_positions(p_query_task, p_map_iteration);
+	}
 
 	// Check for trivial cases.
 	if (!p_query_task.begin_polygon || !p_query_task.end_polygon) {
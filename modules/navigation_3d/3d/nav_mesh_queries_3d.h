@@ -32,6 +32,7 @@
 
 #include "../nav_utils_3d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/a_hash_map.h"
 
 #include "servers/nav_heap.h"
@@ -53,6 +54,11 @@ public:
 		bool in_use = false;
 		uint32_t slot_index = 0;
 		AHashMap<const Nav3D::Polygon *, uint32_t> poly_to_id;
+
+		// Coarse search over the polygon clusters of the map iteration.
+		LocalVector<Nav3D::NavigationCluster> cluster_corridor;
+		Heap<Nav3D::NavigationCluster *, Nav3D::NavClusterTravelCostGreaterThan, Nav3D::NavClusterHeapIndexer> traversable_clusters;
+		LocalVector<uint8_t> clusters_in_corridor;
 	};
 
 	struct NavMeshPathQueryTask3D {
@@ -89,7 +95,9 @@ public:
 		Vector3 end_position;
 		const Nav3D::Polygon *begin_polygon = nullptr;
 		const Nav3D::Polygon *end_polygon = nullptr;
+		bool start_end_positions_resolved = false; // Already looked up by the batch the query belongs to.
 		uint32_t least_cost_id = 0;
+		const LocalVector<uint32_t> *polygon_clusters = nullptr; // Set while the search is limited to the cluster corridor.
 
 		// Map.
 		Vector3 map_up;
@@ -123,6 +131,24 @@ public:
 		}
 	};
 
+	// Path queries solved together against the same map iteration. Queries with the same filters
+	// share the closest polygon lookups of identical start and target positions.
+	struct PathQueryBatch3D {
+		struct PositionLookup {
+			uint32_t filter_query_task = 0; // Query task whose filters are used for the lookup.
+			Vector3 position;
+			const Nav3D::Polygon *polygon = nullptr;
+			Vector3 closest_position;
+		};
+
+		LocalVector<NavMeshPathQueryTask3D> query_tasks;
+		LocalVector<PositionLookup> position_lookups;
+		LocalVector<uint32_t> query_task_position_lookups; // Start and target lookup of each query task.
+		Callable callback;
+		NavMapIteration3D *map_iteration = nullptr;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
 	static bool emit_callback(const Callable &p_callback);
 
 	static Vector3 polygons_get_random_point(const LocalVector<Nav3D::Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly);
@@ -141,10 +167,20 @@ public:
 	static Vector3 map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly);
 
 	static void map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback);
+	static void map_query_paths(NavMap3D *map, const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback);
+
+	static void query_batch_prepare_position_lookups(PathQueryBatch3D &p_batch);
+	static void query_batch_map_iteration_lookup_position(PathQueryBatch3D &p_batch, uint32_t p_lookup_index, const NavMapIteration3D &p_map_iteration);
+	static void query_batch_apply_position_lookups(PathQueryBatch3D &p_batch);
+	static void query_batch_dispatch_results(PathQueryBatch3D &p_batch);
 
 	static void query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_push_back_point_with_metadata(NavMeshPathQueryTask3D &p_query_task, const Vector3 &p_point, const Nav3D::Polygon *p_point_polygon);
+	static void _query_task_set_parameters(NavMeshPathQueryTask3D &p_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters);
+	static void _query_task_set_result(const NavMeshPathQueryTask3D &p_query_task, Ref<NavigationPathQueryResult3D> p_query_result);
+	static bool _query_tasks_have_same_filters(const NavMeshPathQueryTask3D &p_query_task_a, const NavMeshPathQueryTask3D &p_query_task_b);
 	static void _query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static bool _query_task_build_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_post_process_corridorfunnel(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_edgecentered(NavMeshPathQueryTask3D &p_query_task);
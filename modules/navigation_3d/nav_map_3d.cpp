@@ -150,34 +150,125 @@ void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task
 
 	GET_MAP_ITERATION();
 
-	map_iteration.path_query_slots_semaphore.wait();
+	_query_path_in_iteration(p_query_task, map_iteration);
+}
+
+void NavMap3D::_query_path_in_iteration(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task, NavMapIteration3D &p_map_iteration) {
+	p_map_iteration.path_query_slots_semaphore.wait();
 
-	map_iteration.path_query_slots_mutex.lock();
-	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : map_iteration.path_query_slots) {
+	p_map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : p_map_iteration.path_query_slots) {
 		if (!p_path_query_slot.in_use) {
 			p_path_query_slot.in_use = true;
 			p_query_task.path_query_slot = &p_path_query_slot;
 			break;
 		}
 	}
-	map_iteration.path_query_slots_mutex.unlock();
+	p_map_iteration.path_query_slots_mutex.unlock();
 
 	if (p_query_task.path_query_slot == nullptr) {
-		map_iteration.path_query_slots_semaphore.post();
+		p_map_iteration.path_query_slots_semaphore.post();
 		ERR_FAIL_NULL_MSG(p_query_task.path_query_slot, "No unused NavMap3D path query slot found! This should never happen :(.");
 	}
 
-	p_query_task.map_up = map_iteration.map_up;
+	p_query_task.map_up = p_map_iteration.map_up;
 
-	NavMeshQueries3D::query_task_map_iteration_get_path(p_query_task, map_iteration);
+	NavMeshQueries3D::query_task_map_iteration_get_path(p_query_task, p_map_iteration);
 
-	map_iteration.path_query_slots_mutex.lock();
+	p_map_iteration.path_query_slots_mutex.lock();
 	uint32_t used_slot_index = p_query_task.path_query_slot->slot_index;
-	map_iteration.path_query_slots[used_slot_index].in_use = false;
+	p_map_iteration.path_query_slots[used_slot_index].in_use = false;
 	p_query_task.path_query_slot = nullptr;
-	map_iteration.path_query_slots_mutex.unlock();
+	p_map_iteration.path_query_slots_mutex.unlock();
+
+	p_map_iteration.path_query_slots_semaphore.post();
+}
+
+void NavMap3D::query_paths(NavMeshQueries3D::PathQueryBatch3D *p_batch) {
+	if (p_batch->callback.is_valid() && use_threads) {
+		// Run in the background, results and callback are delivered on a later sync.
+		MutexLock lock(path_query_batches_mutex);
+		p_batch->task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &NavMap3D::_run_path_query_batch_task, p_batch, false, SNAME("NavMapPathQueryBatch3D"));
+		path_query_batches.push_back(p_batch);
+		return;
+	}
 
-	map_iteration.path_query_slots_semaphore.post();
+	_run_path_query_batch(p_batch, use_threads);
+	NavMeshQueries3D::query_batch_dispatch_results(*p_batch);
+	memdelete(p_batch);
+}
+
+void NavMap3D::_run_path_query_batch_task(NavMeshQueries3D::PathQueryBatch3D *p_batch) {
+	// Waiting on group tasks from a low priority task would hold a pool thread, so background batches run serially.
+	_run_path_query_batch(p_batch, false);
+}
+
+void NavMap3D::_run_path_query_batch(NavMeshQueries3D::PathQueryBatch3D *p_batch, bool p_use_group_tasks) {
+	if (iteration_id == 0 || p_batch->query_tasks.is_empty()) {
+		return;
+	}
+
+	// All queries of the batch use the same iteration.
+	GET_MAP_ITERATION();
+	p_batch->map_iteration = &map_iteration;
+
+	NavMeshQueries3D::query_batch_prepare_position_lookups(*p_batch);
+
+	const uint32_t lookup_count = p_batch->position_lookups.size();
+	if (p_use_group_tasks && lookup_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::_path_query_batch_lookup_position, p_batch, lookup_count, -1, true, SNAME("NavMapPathQueryBatchLookups3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < lookup_count; i++) {
+			_path_query_batch_lookup_position(i, p_batch);
+		}
+	}
+
+	NavMeshQueries3D::query_batch_apply_position_lookups(*p_batch);
+
+	const uint32_t query_count = p_batch->query_tasks.size();
+	if (p_use_group_tasks && query_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::_path_query_batch_query_path, p_batch, query_count, -1, true, SNAME("NavMapPathQueryBatch3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < query_count; i++) {
+			_path_query_batch_query_path(i, p_batch);
+		}
+	}
+
+	p_batch->map_iteration = nullptr;
+}
+
+void NavMap3D::_path_query_batch_lookup_position(uint32_t p_index, NavMeshQueries3D::PathQueryBatch3D *p_batch) {
+	NavMeshQueries3D::query_batch_map_iteration_lookup_position(*p_batch, p_index, *p_batch->map_iteration);
+}
+
+void NavMap3D::_path_query_batch_query_path(uint32_t p_index, NavMeshQueries3D::PathQueryBatch3D *p_batch) {
+	_query_path_in_iteration(p_batch->query_tasks[p_index], *p_batch->map_iteration);
+}
+
+void NavMap3D::_sync_path_query_batches() {
+	// Deliver in submission order.
+	LocalVector<NavMeshQueries3D::PathQueryBatch3D *> finished_batches;
+	{
+		MutexLock lock(path_query_batches_mutex);
+		uint32_t finished_count = 0;
+		while (finished_count < path_query_batches.size() && WorkerThreadPool::get_singleton()->is_task_completed(path_query_batches[finished_count]->task_id)) {
+			finished_batches.push_back(path_query_batches[finished_count]);
+			finished_count++;
+		}
+		for (uint32_t i = finished_count; i < path_query_batches.size(); i++) {
+			path_query_batches[i - finished_count] = path_query_batches[i];
+		}
+		path_query_batches.resize(path_query_batches.size() - finished_count);
+	}
+
+	// Callbacks may submit new batches, so they are called without holding the lock.
+	for (NavMeshQueries3D::PathQueryBatch3D *batch : finished_batches) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(batch->task_id);
+		NavMeshQueries3D::query_batch_dispatch_results(*batch);
+		memdelete(batch);
+	}
 }
 
 Vector3 NavMap3D::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -368,6 +459,8 @@ void NavMap3D::_build_iteration() {
 	iteration_build.use_edge_connections = get_use_edge_connections();
 	iteration_build.edge_connection_margin = get_edge_connection_margin();
 	iteration_build.link_connection_radius = get_link_connection_radius();
+	iteration_build.use_hierarchical_path_search = use_hierarchical_path_search;
+	iteration_build.hierarchical_path_search_cluster_size = hierarchical_path_search_cluster_size;
 
 	next_map_iteration.clear();
 
@@ -434,6 +527,7 @@ void NavMap3D::sync() {
 	performance_data.pm_obstacle_count = obstacles.size();
 
 	_sync_async_tasks();
+	_sync_path_query_batches();
 
 	_sync_dirty_map_update_requests();
 
@@ -592,50 +686,63 @@ void NavMap3D::_update_rvo_simulation() {
 	}
 }
 
+// Avoidance runs in two passes so the result does not depend on the order agents are processed in,
+// or on how they are spread over threads. The first pass only reads the shared simulation state and
+// writes the new velocity of each agent, the second one applies the new velocities.
+
 void NavMap3D::compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-	(*(agent + index))->update();
+	RVO2D::Agent2D *rvo_agent = (*(agent + index))->get_rvo_agent_2d();
+	rvo_agent->computeNeighbors(&rvo_simulation_2d);
+	rvo_agent->computeNewVelocity(&rvo_simulation_2d);
 }
 
 void NavMap3D::compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-	(*(agent + index))->update();
+	RVO3D::Agent3D *rvo_agent = (*(agent + index))->get_rvo_agent_3d();
+	rvo_agent->computeNeighbors(&rvo_simulation_3d);
+	rvo_agent->computeNewVelocity(&rvo_simulation_3d);
 }
 
 void NavMap3D::step(double p_delta_time) {
 	rvo_simulation_2d.setTimeStep(float(p_delta_time));
 	rvo_simulation_3d.setTimeStep(float(p_delta_time));
 
+	const bool use_group_tasks = use_threads && avoidance_use_multiple_threads;
+
 	if (active_2d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
+		if (use_group_tasks && active_2d_avoidance_agents.size() > 1) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
-			for (NavAgent3D *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-				agent->update();
+			for (uint32_t i = 0; i < active_2d_avoidance_agents.size(); i++) {
+				compute_single_avoidance_step_2d(i, active_2d_avoidance_agents.ptr());
 			}
 		}
+
+		for (NavAgent3D *agent : active_2d_avoidance_agents) {
+			agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
+			agent->update();
+		}
 	}
 
 	if (active_3d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
+		if (use_group_tasks && active_3d_avoidance_agents.size() > 1) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
-			for (NavAgent3D *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-				agent->update();
+			for (uint32_t i = 0; i < active_3d_avoidance_agents.size(); i++) {
+				compute_single_avoidance_step_3d(i, active_3d_avoidance_agents.ptr());
 			}
 		}
+
+		for (NavAgent3D *agent : active_3d_avoidance_agents) {
+			agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
+			agent->update();
+		}
+	}
+
+	if (active_2d_avoidance_agents.size() > 0 || active_3d_avoidance_agents.size() > 0) {
+		// Agents moved, rebuild the neighbor trees once before the next step.
+		agents_dirty = true;
 	}
 }
 
@@ -869,6 +976,9 @@ NavMap3D::NavMap3D() {
 		path_query_slots_max = 1;
 	}
 
+	use_hierarchical_path_search = GLOBAL_GET("navigation/3d/use_hierarchical_path_search");
+	hierarchical_path_search_cluster_size = MAX(1, int(GLOBAL_GET("navigation/3d/hierarchical_path_search_cluster_size")));
+
 	iteration_slots.resize(2);
 
 	for (NavMapIteration3D &iteration_slot : iteration_slots) {
@@ -892,6 +1002,14 @@ NavMap3D::~NavMap3D() {
 		iteration_build_thread_task_id = WorkerThreadPool::INVALID_TASK_ID;
 	}
 
+	// Pending batches are dropped without calling back, their map is gone.
+	MutexLock batches_lock(path_query_batches_mutex);
+	for (NavMeshQueries3D::PathQueryBatch3D *batch : path_query_batches) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(batch->task_id);
+		memdelete(batch);
+	}
+	path_query_batches.clear();
+
 	RWLockWrite write_lock(iteration_slot_rwlock);
 	for (NavMapIteration3D &iteration_slot : iteration_slots) {
 		iteration_slot.clear();
@@ -102,6 +102,10 @@ class NavMap3D : public NavRid3D {
 	/// Change the id each time the map is updated.
 	uint32_t iteration_id = 0;
 
+	/// Path query batches running on threads, results are delivered on sync.
+	LocalVector<NavMeshQueries3D::PathQueryBatch3D *> path_query_batches;
+	Mutex path_query_batches_mutex;
+
 	bool use_threads = true;
 	bool avoidance_use_multiple_threads = true;
 	bool avoidance_use_high_priority_threads = true;
@@ -139,6 +143,9 @@ class NavMap3D : public NavRid3D {
 
 	bool use_async_iterations = true;
 
+	bool use_hierarchical_path_search = false;
+	uint32_t hierarchical_path_search_cluster_size = 128;
+
 	uint32_t iteration_slot_index = 0;
 	LocalVector<NavMapIteration3D> iteration_slots;
 	mutable RWLock iteration_slot_rwlock;
@@ -197,6 +204,7 @@ public:
 	const Vector3 &get_merge_rasterizer_cell_size() const;
 
 	void query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task);
+	void query_paths(NavMeshQueries3D::PathQueryBatch3D *p_batch);
 
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
@@ -274,6 +282,13 @@ private:
 	void _sync_dirty_map_update_requests();
 	void _sync_dirty_avoidance_update_requests();
 	void _sync_async_tasks();
+	void _sync_path_query_batches();
+
+	void _query_path_in_iteration(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task, NavMapIteration3D &p_map_iteration);
+	void _run_path_query_batch(NavMeshQueries3D::PathQueryBatch3D *p_batch, bool p_use_group_tasks);
+	void _run_path_query_batch_task(NavMeshQueries3D::PathQueryBatch3D *p_batch);
+	void _path_query_batch_lookup_position(uint32_t p_index, NavMeshQueries3D::PathQueryBatch3D *p_batch);
+	void _path_query_batch_query_path(uint32_t p_index, NavMeshQueries3D::PathQueryBatch3D *p_batch);
 
 	void compute_single_step(uint32_t index, NavAgent3D **agent);
 
@@ -171,6 +171,73 @@ struct NavPolyHeapIndexer {
 	}
 };
 
+struct PolygonCluster {
+	/// Navigation region or link that contains the polygons of this cluster.
+	const NavBaseIteration3D *owner = nullptr;
+
+	/// Average center of the cluster polygons.
+	Vector3 position;
+};
+
+struct ClusterPortal {
+	/// Cluster that this portal leads to.
+	uint32_t cluster = UINT32_MAX;
+
+	/// Average position of the polygon edges shared with the cluster.
+	Vector3 position;
+};
+
+struct NavigationCluster {
+	/// Index of this cluster.
+	uint32_t cluster = UINT32_MAX;
+
+	/// Index in the heap of traversable clusters.
+	uint32_t traversable_cluster_index = UINT32_MAX;
+
+	/// The cluster this cluster was entered from.
+	uint32_t back_cluster = UINT32_MAX;
+
+	/// The entry position of this cluster.
+	Vector3 entry;
+	/// The distance traveled until now (g cost).
+	real_t traveled_distance = 0.0;
+	/// The distance to the destination (h cost).
+	real_t distance_to_destination = 0.0;
+
+	/// The total travel cost (f cost).
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
+
+	void reset() {
+		cluster = UINT32_MAX;
+		traversable_cluster_index = UINT32_MAX;
+		back_cluster = UINT32_MAX;
+		traveled_distance = FLT_MAX;
+		distance_to_destination = 0.0;
+	}
+};
+
+struct NavClusterTravelCostGreaterThan {
+	// Returns `true` if the travel cost of `a` is higher than that of `b`.
+	bool operator()(const NavigationCluster *p_cluster_a, const NavigationCluster *p_cluster_b) const {
+		real_t f_cost_a = p_cluster_a->total_travel_cost();
+		real_t f_cost_b = p_cluster_b->total_travel_cost();
+
+		if (f_cost_a != f_cost_b) {
+			return f_cost_a > f_cost_b;
+		} else {
+			return p_cluster_a->distance_to_destination > p_cluster_b->distance_to_destination;
+		}
+	}
+};
+
+struct NavClusterHeapIndexer {
+	void operator()(NavigationCluster *p_cluster, uint32_t p_heap_index) const {
+		p_cluster->traversable_cluster_index = p_heap_index;
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
@@ -147,22 +147,24 @@ Vector<int> TileMap::_get_tile_map_data_using_compatibility_format(int p_layer)
 	ERR_FAIL_INDEX_V(p_layer, (int)layers.size(), Vector<int>());
 
 	// Export tile data to raw format.
-	const HashMap<Vector2i, CellData> tile_map_layer_data = layers[p_layer]->get_tile_map_layer_data();
+	const CellDataMap &tile_map_layer_data = layers[p_layer]->get_tile_map_layer_data();
 	Vector<int> tile_data;
 	tile_data.resize(tile_map_layer_data.size() * 3);
 	int *w = tile_data.ptrw();
 
-	// Save in highest format.
+	// Save in highest format, sorted by coords so the output stays stable.
+	LocalVector<const CellDataMap::Element *> sorted_cells;
+	tile_map_layer_data.get_elements_sorted_by_coords(sorted_cells);
 
 	int idx = 0;
-	for (const KeyValue<Vector2i, CellData> &E : tile_map_layer_data) {
+	for (const CellDataMap::Element *E : sorted_cells) {
 		uint8_t *ptr = (uint8_t *)&w[idx];
-		encode_uint16((int16_t)(E.key.x), &ptr[0]);
-		encode_uint16((int16_t)(E.key.y), &ptr[2]);
-		encode_uint16(E.value.cell.source_id, &ptr[4]);
-		encode_uint16(E.value.cell.coord_x, &ptr[6]);
-		encode_uint16(E.value.cell.coord_y, &ptr[8]);
-		encode_uint16(E.value.cell.alternative_tile, &ptr[10]);
+		encode_uint16((int16_t)(E->key.x), &ptr[0]);
+		encode_uint16((int16_t)(E->key.y), &ptr[2]);
+		encode_uint16(E->value.cell.source_id, &ptr[4]);
+		encode_uint16(E->value.cell.coord_x, &ptr[6]);
+		encode_uint16(E->value.cell.coord_y, &ptr[8]);
+		encode_uint16(E->value.cell.alternative_tile, &ptr[10]);
 		idx += 3;
 	}
 
@@ -33,6 +33,7 @@
 #include "core/io/marshalls.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/a_hash_map.h"
 #include "scene/2d/tile_map.h"
 #include "scene/gui/control.h"
@@ -759,15 +760,13 @@ void TileMapLayer::_physics_update(bool p_force_cleanup) {
 
 	// ----------- Quadrants processing -----------
 
-	// List all physics quadrants to update, creating new ones if needed.
-	SelfList<PhysicsQuadrant>::List dirty_physics_quadrant_list;
-
 	// Check if anything changed that might change the quadrant shape.
 	// If so, recreate everything.
 	bool quadrant_shape_changed = dirty.flags[DIRTY_FLAGS_TILE_SET] || dirty.flags[DIRTY_FLAGS_LAYER_PHYSICS_QUADRANT_SIZE];
 
 	// Free all quadrants.
 	if (!_physics_was_cleaned_up && (forced_cleanup || quadrant_shape_changed)) {
+		dirty_physics_quadrant_list.clear();
 		for (const KeyValue<Vector2i, Ref<PhysicsQuadrant>> &kv : physics_quadrant_map) {
 			// Clear bodies.
 			for (KeyValue<PhysicsQuadrant::PhysicsBodyKey, PhysicsQuadrant::PhysicsBodyValue> &kvbody : kv.value->bodies) {
@@ -802,11 +801,13 @@ void TileMapLayer::_physics_update(bool p_force_cleanup) {
 			}
 		}
 
-		// Update all dirty quadrants.
-		for (SelfList<PhysicsQuadrant> *quadrant_list_element = dirty_physics_quadrant_list.first(); quadrant_list_element;) {
-			SelfList<PhysicsQuadrant> *next_quadrant_list_element = quadrant_list_element->next(); // "Hack" to clear the list while iterating.
-
-			const Ref<PhysicsQuadrant> &physics_quadrant = quadrant_list_element->self();
+		// Pick the dirty quadrants to update, the ones over the budget are kept for the next updates.
+		LocalVector<Ref<PhysicsQuadrant>> quadrants_to_rebuild;
+		int updated_quadrants_count = 0;
+		while (dirty_physics_quadrant_list.first() && (physics_quadrant_update_budget <= 0 || updated_quadrants_count < physics_quadrant_update_budget)) {
+			Ref<PhysicsQuadrant> physics_quadrant = dirty_physics_quadrant_list.first()->self();
+			dirty_physics_quadrant_list.remove(&physics_quadrant->dirty_quadrant_list_element);
+			updated_quadrants_count++;
 
 			// Check if the quadrant has a tile.
 			bool has_a_tile = false;
@@ -819,149 +820,163 @@ void TileMapLayer::_physics_update(bool p_force_cleanup) {
 			}
 
 			if (has_a_tile) {
-				// Process the quadrant.
-
-				// First, clear the quadrant bodies.
-				for (KeyValue<PhysicsQuadrant::PhysicsBodyKey, PhysicsQuadrant::PhysicsBodyValue> &kvbody : physics_quadrant->bodies) {
-					RID &body = kvbody.value.body;
+				quadrants_to_rebuild.push_back(physics_quadrant);
+			} else {
+				// Free the quadrant.
+				for (KeyValue<PhysicsQuadrant::PhysicsBodyKey, PhysicsQuadrant::PhysicsBodyValue> &kv : physics_quadrant->bodies) {
+					RID &body = kv.value.body;
 					if (body.is_valid()) {
 						bodies_coords.erase(body);
 						ps->free_rid(body);
-						body = RID();
 					}
 				}
 				physics_quadrant->bodies.clear();
-				physics_quadrant->shapes.clear();
-
-				// Quadrant origin
-				Vector2 quadrant_origin = tile_set->map_to_local(physics_quadrant->quadrant_coords);
+				physics_quadrant->cells.clear();
+				physics_quadrant_map.erase(physics_quadrant->quadrant_coords);
+			}
+		}
 
-				// Recreate the quadrant bodies.
-				for (uint32_t tile_set_physics_layer = 0; tile_set_physics_layer < (uint32_t)tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
-					Ref<PhysicsMaterial> physics_material = tile_set->get_physics_layer_physics_material(tile_set_physics_layer);
-					uint32_t physics_layer = tile_set->get_physics_layer_collision_layer(tile_set_physics_layer);
-					uint32_t physics_mask = tile_set->get_physics_layer_collision_mask(tile_set_physics_layer);
+		// Gather the polygons of each quadrant to rebuild, grouped per body.
+		LocalVector<PhysicsQuadrant::PhysicsBodyValue *> bodies_to_merge;
+		for (const Ref<PhysicsQuadrant> &physics_quadrant : quadrants_to_rebuild) {
+			physics_quadrant->rebuilt_bodies.clear();
 
-					// Merge polygons together for each quadrant.
-					for (SelfList<CellData> *cell_data_quadrant_list_element = physics_quadrant->cells.first(); cell_data_quadrant_list_element; cell_data_quadrant_list_element = cell_data_quadrant_list_element->next()) {
-						CellData &cell_data = *cell_data_quadrant_list_element->self();
+			// Quadrant origin
+			Vector2 quadrant_origin = tile_set->map_to_local(physics_quadrant->quadrant_coords);
 
-						TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*tile_set->get_source(cell_data.cell.source_id));
+			for (uint32_t tile_set_physics_layer = 0; tile_set_physics_layer < (uint32_t)tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
+				// Merge polygons together for each quadrant.
+				for (SelfList<CellData> *cell_data_quadrant_list_element = physics_quadrant->cells.first(); cell_data_quadrant_list_element; cell_data_quadrant_list_element = cell_data_quadrant_list_element->next()) {
+					CellData &cell_data = *cell_data_quadrant_list_element->self();
 
-						// Get the tile data.
-						const TileData *tile_data;
-						if (cell_data.runtime_tile_data_cache) {
-							tile_data = cell_data.runtime_tile_data_cache;
-						} else {
-							tile_data = atlas_source->get_tile_data(cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile);
-						}
+					TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*tile_set->get_source(cell_data.cell.source_id));
 
-						// Transform flags.
-						bool flip_h = (cell_data.cell.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H);
-						bool flip_v = (cell_data.cell.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V);
-						bool transpose = (cell_data.cell.alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
-
-						Vector2 linear_velocity = tile_data->get_constant_linear_velocity(tile_set_physics_layer);
-						real_t angular_velocity = tile_data->get_constant_angular_velocity(tile_set_physics_layer);
-
-						// Setup polygons for merge.
-						for (int polygon_index = 0; polygon_index < tile_data->get_collision_polygons_count(tile_set_physics_layer); polygon_index++) {
-							// Iterate over the polygons.
-							int shapes_count = tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index);
-
-							// Check if we need to create a new body.
-							PhysicsQuadrant::PhysicsBodyKey physics_body_key;
-							physics_body_key.physics_layer = tile_set_physics_layer;
-							physics_body_key.linear_velocity = linear_velocity;
-							physics_body_key.angular_velocity = angular_velocity;
-							physics_body_key.one_way_collision = tile_data->is_collision_polygon_one_way(tile_set_physics_layer, polygon_index);
-							physics_body_key.one_way_collision_margin = tile_data->get_collision_polygon_one_way_margin(tile_set_physics_layer, polygon_index);
-							physics_body_key.y_origin = map_to_local(cell_data.coords).y;
-
-							if (!physics_quadrant->bodies.has(physics_body_key)) {
-								RID body = ps->body_create();
-								physics_quadrant->bodies[physics_body_key] = {};
-								physics_quadrant->bodies[physics_body_key].body = body;
-								bodies_coords[body] = physics_quadrant->quadrant_coords;
-
-								// Create or update the body.
-								ps->body_set_mode(body, use_kinematic_bodies ? PhysicsServer2D::BODY_MODE_KINEMATIC : PhysicsServer2D::BODY_MODE_STATIC);
-								ps->body_set_space(body, space);
-
-								Transform2D xform;
-								xform.set_origin(quadrant_origin);
-								xform = gl_transform * xform;
-								ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
-
-								ps->body_attach_object_instance_id(body, tile_map_node ? tile_map_node->get_instance_id() : get_instance_id());
-								ps->body_set_collision_layer(body, physics_layer);
-								ps->body_set_collision_mask(body, physics_mask);
-								ps->body_set_pickable(body, false);
-								ps->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, linear_velocity);
-								ps->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, angular_velocity);
-
-								if (!physics_material.is_valid()) {
-									ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, 0);
-									ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, 1);
-								} else {
-									ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, physics_material->computed_bounce());
-									ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, physics_material->computed_friction());
-								}
-							}
+					// Get the tile data.
+					const TileData *tile_data;
+					if (cell_data.runtime_tile_data_cache) {
+						tile_data = cell_data.runtime_tile_data_cache;
+					} else {
+						tile_data = atlas_source->get_tile_data(cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile);
+					}
 
-							for (int shape_index = 0; shape_index < shapes_count; shape_index++) {
-								Ref<ConvexPolygonShape2D> shape = tile_data->get_collision_polygon_shape(tile_set_physics_layer, polygon_index, shape_index, flip_h, flip_v, transpose);
+					// Transform flags.
+					bool flip_h = (cell_data.cell.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H);
+					bool flip_v = (cell_data.cell.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V);
+					bool transpose = (cell_data.cell.alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
+
+					Vector2 linear_velocity = tile_data->get_constant_linear_velocity(tile_set_physics_layer);
+					real_t angular_velocity = tile_data->get_constant_angular_velocity(tile_set_physics_layer);
+
+					// Setup polygons for merge.
+					for (int polygon_index = 0; polygon_index < tile_data->get_collision_polygons_count(tile_set_physics_layer); polygon_index++) {
+						// Iterate over the polygons.
+						int shapes_count = tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index);
+
+						PhysicsQuadrant::PhysicsBodyKey physics_body_key;
+						physics_body_key.physics_layer = tile_set_physics_layer;
+						physics_body_key.linear_velocity = linear_velocity;
+						physics_body_key.angular_velocity = angular_velocity;
+						physics_body_key.one_way_collision = tile_data->is_collision_polygon_one_way(tile_set_physics_layer, polygon_index);
+						physics_body_key.one_way_collision_margin = tile_data->get_collision_polygon_one_way_margin(tile_set_physics_layer, polygon_index);
+						physics_body_key.y_origin = map_to_local(cell_data.coords).y;
+
+						PhysicsQuadrant::PhysicsBodyValue *body_value = physics_quadrant->rebuilt_bodies.getptr(physics_body_key);
+						if (!body_value) {
+							body_value = &physics_quadrant->rebuilt_bodies.insert(physics_body_key, PhysicsQuadrant::PhysicsBodyValue())->value;
+							bodies_to_merge.push_back(body_value);
+						}
 
-								// Translate the polygon.
-								Vector<Vector2> convex_polygon = shape->get_points();
-								for (int i = 0; i < convex_polygon.size(); i++) {
-									convex_polygon.set(i, convex_polygon[i] + tile_set->map_to_local(cell_data.coords) - quadrant_origin);
-								}
+						for (int shape_index = 0; shape_index < shapes_count; shape_index++) {
+							Ref<ConvexPolygonShape2D> shape = tile_data->get_collision_polygon_shape(tile_set_physics_layer, polygon_index, shape_index, flip_h, flip_v, transpose);
 
-								physics_quadrant->bodies[physics_body_key].polygons.push_back(convex_polygon);
+							// Translate the polygon.
+							Vector<Vector2> convex_polygon = shape->get_points();
+							for (int i = 0; i < convex_polygon.size(); i++) {
+								convex_polygon.set(i, convex_polygon[i] + tile_set->map_to_local(cell_data.coords) - quadrant_origin);
 							}
+
+							body_value->polygons.push_back(convex_polygon);
 						}
 					}
 				}
+			}
+		}
 
-				// Iterate over the bodies
-				for (const KeyValue<PhysicsQuadrant::PhysicsBodyKey, PhysicsQuadrant::PhysicsBodyValue> &kvbody : physics_quadrant->bodies) {
-					// Actually merge the polygons.
-					Vector<Vector<Vector2>> out_polygons;
-					Vector<Vector<Vector2>> out_holes;
-					Geometry2D::merge_many_polygons(kvbody.value.polygons, out_polygons, out_holes);
-					// Create shapes for each polygon.
-					int body_shape_index = 0;
-					Vector<Vector<Vector2>> convex_polygons = Geometry2D::decompose_many_polygons_in_convex(out_polygons, out_holes);
-					for (Vector<Vector2> &convex_polygon : convex_polygons) {
-						Ref<ConvexPolygonShape2D> shape;
-						shape.instantiate();
-						shape->set_points(convex_polygon);
-						ps->body_add_shape(kvbody.value.body, shape->get_rid());
-						ps->body_set_shape_as_one_way_collision(kvbody.value.body, body_shape_index, kvbody.key.one_way_collision, kvbody.key.one_way_collision_margin);
-						physics_quadrant->shapes.push_back(shape);
-						body_shape_index++;
-					}
+		// Merging and decomposing polygons is the most expensive part, and does not depend on any server.
+		if (bodies_to_merge.size() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&TileMapLayer::_physics_merge_body_polygons, &bodies_to_merge, bodies_to_merge.size(), -1, true, SNAME("TileMapLayerMergeCollisionPolygons"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else if (bodies_to_merge.size() == 1) {
+			_physics_merge_body_polygons(&bodies_to_merge, 0);
+		}
+
+		// Replace the bodies of each rebuilt quadrant at once.
+		for (const Ref<PhysicsQuadrant> &physics_quadrant : quadrants_to_rebuild) {
+			// First, clear the quadrant bodies.
+			for (KeyValue<PhysicsQuadrant::PhysicsBodyKey, PhysicsQuadrant::PhysicsBodyValue> &kvbody : physics_quadrant->bodies) {
+				RID &body = kvbody.value.body;
+				if (body.is_valid()) {
+					bodies_coords.erase(body);
+					ps->free_rid(body);
+					body = RID();
 				}
-			} else {
-				// Free the quadrant.
-				for (KeyValue<PhysicsQuadrant::PhysicsBodyKey, PhysicsQuadrant::PhysicsBodyValue> &kv : physics_quadrant->bodies) {
-					RID &body = kv.value.body;
-					if (body.is_valid()) {
-						bodies_coords.erase(body);
-						ps->free_rid(body);
-					}
+			}
+			physics_quadrant->bodies.clear();
+			physics_quadrant->shapes.clear();
+
+			// Quadrant origin
+			Vector2 quadrant_origin = tile_set->map_to_local(physics_quadrant->quadrant_coords);
+
+			for (KeyValue<PhysicsQuadrant::PhysicsBodyKey, PhysicsQuadrant::PhysicsBodyValue> &kvbody : physics_quadrant->rebuilt_bodies) {
+				const PhysicsQuadrant::PhysicsBodyKey &physics_body_key = kvbody.key;
+				Ref<PhysicsMaterial> physics_material = tile_set->get_physics_layer_physics_material(physics_body_key.physics_layer);
+
+				// Create the body.
+				RID body = ps->body_create();
+				kvbody.value.body = body;
+				bodies_coords[body] = physics_quadrant->quadrant_coords;
+
+				ps->body_set_mode(body, use_kinematic_bodies ? PhysicsServer2D::BODY_MODE_KINEMATIC : PhysicsServer2D::BODY_MODE_STATIC);
+				ps->body_set_space(body, space);
+
+				Transform2D xform;
+				xform.set_origin(quadrant_origin);
+				xform = gl_transform * xform;
+				ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
+
+				ps->body_attach_object_instance_id(body, tile_map_node ? tile_map_node->get_instance_id() : get_instance_id());
+				ps->body_set_collision_layer(body, tile_set->get_physics_layer_collision_layer(physics_body_key.physics_layer));
+				ps->body_set_collision_mask(body, tile_set->get_physics_layer_collision_mask(physics_body_key.physics_layer));
+				ps->body_set_pickable(body, false);
+				ps->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, physics_body_key.linear_velocity);
+				ps->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, physics_body_key.angular_velocity);
+
+				if (!physics_material.is_valid()) {
+					ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, 0);
+					ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, 1);
+				} else {
+					ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, physics_material->computed_bounce());
+					ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, physics_material->computed_friction());
 				}
-				physics_quadrant->bodies.clear();
-				physics_quadrant->cells.clear();
-				physics_quadrant_map.erase(physics_quadrant->quadrant_coords);
+
+				// Create shapes for each polygon.
+				int body_shape_index = 0;
+				for (const Vector<Vector2> &convex_polygon : kvbody.value.convex_polygons) {
+					Ref<ConvexPolygonShape2D> shape;
+					shape.instantiate();
+					shape->set_points(convex_polygon);
+					ps->body_add_shape(body, shape->get_rid());
+					ps->body_set_shape_as_one_way_collision(body, body_shape_index, physics_body_key.one_way_collision, physics_body_key.one_way_collision_margin);
+					physics_quadrant->shapes.push_back(shape);
+					body_shape_index++;
+				}
+				kvbody.value.convex_polygons.clear();
 			}
 
-			quadrant_list_element = next_quadrant_list_element;
+			physics_quadrant->bodies = physics_quadrant->rebuilt_bodies;
+			physics_quadrant->rebuilt_bodies.clear();
 		}
 
-		dirty_physics_quadrant_list.clear();
-
 		// Updates on physics changes.
 		if (dirty.flags[DIRTY_FLAGS_LAYER_USE_KINEMATIC_BODIES]) {
 			for (KeyValue<Vector2i, Ref<PhysicsQuadrant>> &kv : physics_quadrant_map) {
@@ -978,6 +993,16 @@ void TileMapLayer::_physics_update(bool p_force_cleanup) {
 	_physics_was_cleaned_up = forced_cleanup;
 }
 
+void TileMapLayer::_physics_merge_body_polygons(void *p_userdata, uint32_t p_index) {
+	PhysicsQuadrant::PhysicsBodyValue *body_value = (*(LocalVector<PhysicsQuadrant::PhysicsBodyValue *> *)p_userdata)[p_index];
+
+	// Actually merge the polygons.
+	Vector<Vector<Vector2>> out_polygons;
+	Vector<Vector<Vector2>> out_holes;
+	Geometry2D::merge_many_polygons(body_value->polygons, out_polygons, out_holes);
+	body_value->convex_polygons = Geometry2D::decompose_many_polygons_in_convex(out_polygons, out_holes);
+}
+
 void TileMapLayer::_physics_quadrants_update_cell(CellData &r_cell_data, SelfList<PhysicsQuadrant>::List &r_dirty_physics_quadrant_list) {
 	// Check if the cell is valid and retrieve its y_sort_origin.
 	bool is_valid = false;
@@ -2082,6 +2107,17 @@ void TileMapLayer::_internal_update(bool p_force_cleanup) {
 	dirty.cell_list.clear();
 
 	pending_update = false;
+
+#ifndef PHYSICS_2D_DISABLED
+	// Continue with the physics quadrants that did not fit in the update budget on the next frame.
+	// Queuing the update right away would run it during the same message queue flush.
+	if (dirty_physics_quadrant_list.first() && is_inside_tree()) {
+		Callable continue_update = callable_mp(this, &TileMapLayer::_queue_internal_update);
+		if (!get_tree()->is_connected(SNAME("process_frame"), continue_update)) {
+			get_tree()->connect(SNAME("process_frame"), continue_update, CONNECT_ONE_SHOT);
+		}
+	}
+#endif // PHYSICS_2D_DISABLED
 }
 
 void TileMapLayer::_physics_interpolated_changed() {
@@ -2230,6 +2266,8 @@ void TileMapLayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_collision_visibility_mode"), &TileMapLayer::get_collision_visibility_mode);
 	ClassDB::bind_method(D_METHOD("set_physics_quadrant_size", "size"), &TileMapLayer::set_physics_quadrant_size);
 	ClassDB::bind_method(D_METHOD("get_physics_quadrant_size"), &TileMapLayer::get_physics_quadrant_size);
+	ClassDB::bind_method(D_METHOD("set_physics_quadrant_update_budget", "budget"), &TileMapLayer::set_physics_quadrant_update_budget);
+	ClassDB::bind_method(D_METHOD("get_physics_quadrant_update_budget"), &TileMapLayer::get_physics_quadrant_update_budget);
 
 	ClassDB::bind_method(D_METHOD("set_occlusion_enabled", "enabled"), &TileMapLayer::set_occlusion_enabled);
 	ClassDB::bind_method(D_METHOD("is_occlusion_enabled"), &TileMapLayer::is_occlusion_enabled);
@@ -2261,6 +2299,7 @@ void TileMapLayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_kinematic_bodies"), "set_use_kinematic_bodies", "is_using_kinematic_bodies");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_visibility_mode", PROPERTY_HINT_ENUM, "Default,Force Show,Force Hide"), "set_collision_visibility_mode", "get_collision_visibility_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "physics_quadrant_size"), "set_physics_quadrant_size", "get_physics_quadrant_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "physics_quadrant_update_budget", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), "set_physics_quadrant_update_budget", "get_physics_quadrant_update_budget");
 #ifndef NAVIGATION_2D_DISABLED
 	ADD_GROUP("Navigation", "navigation_");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "navigation_enabled", PROPERTY_HINT_GROUP_ENABLE), "set_navigation_enabled", "is_navigation_enabled");
@@ -2760,7 +2799,7 @@ void TileMapLayer::compute_transformed_tile_dest_rect(Rect2 &r_dest_rect, bool &
 void TileMapLayer::set_cell(const Vector2i &p_coords, int p_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile) {
 	// Set the current cell tile (using integer position).
 	Vector2i pk(p_coords);
-	HashMap<Vector2i, CellData>::Iterator E = tile_map_layer_data.find(pk);
+	CellDataMap::Iterator E = tile_map_layer_data.find(pk);
 
 	int source_id = p_source_id;
 	Vector2i atlas_coords = p_atlas_coords;
@@ -2831,7 +2870,7 @@ void TileMapLayer::clear() {
 
 int TileMapLayer::get_cell_source_id(const Vector2i &p_coords) const {
 	// Get a cell source id from position.
-	HashMap<Vector2i, CellData>::ConstIterator E = tile_map_layer_data.find(p_coords);
+	CellDataMap::ConstIterator E = tile_map_layer_data.find(p_coords);
 
 	if (!E) {
 		return TileSet::INVALID_SOURCE;
@@ -2842,7 +2881,7 @@ int TileMapLayer::get_cell_source_id(const Vector2i &p_coords) const {
 
 Vector2i TileMapLayer::get_cell_atlas_coords(const Vector2i &p_coords) const {
 	// Get a cell source id from position.
-	HashMap<Vector2i, CellData>::ConstIterator E = tile_map_layer_data.find(p_coords);
+	CellDataMap::ConstIterator E = tile_map_layer_data.find(p_coords);
 
 	if (!E) {
 		return TileSetSource::INVALID_ATLAS_COORDS;
@@ -2853,7 +2892,7 @@ Vector2i TileMapLayer::get_cell_atlas_coords(const Vector2i &p_coords) const {
 
 int TileMapLayer::get_cell_alternative_tile(const Vector2i &p_coords) const {
 	// Get a cell source id from position.
-	HashMap<Vector2i, CellData>::ConstIterator E = tile_map_layer_data.find(p_coords);
+	CellDataMap::ConstIterator E = tile_map_layer_data.find(p_coords);
 
 	if (!E) {
 		return TileSetSource::INVALID_TILE_ALTERNATIVE;
@@ -3257,20 +3296,22 @@ Vector<uint8_t> TileMapLayer::get_tile_map_data_as_array() const {
 	encode_uint16(TileMapLayerDataFormat::TILE_MAP_LAYER_DATA_FORMAT_MAX - 1, &ptr[index]);
 	index += 2;
 
-	// Save in highest format.
-	for (const KeyValue<Vector2i, CellData> &E : tile_map_layer_data) {
+	// Save in highest format, sorted by coords so the output stays stable.
+	LocalVector<const CellDataMap::Element *> sorted_cells;
+	tile_map_layer_data.get_elements_sorted_by_coords(sorted_cells);
+	for (const CellDataMap::Element *E : sorted_cells) {
 		// Get a pointer at the start of the cell data.
 		uint8_t *cell_data_ptr = (uint8_t *)&ptr[index];
 
 		// Store position in TileMap.
-		encode_uint16((int16_t)(E.key.x), &cell_data_ptr[0]);
-		encode_uint16((int16_t)(E.key.y), &cell_data_ptr[2]);
+		encode_uint16((int16_t)(E->key.x), &cell_data_ptr[0]);
+		encode_uint16((int16_t)(E->key.y), &cell_data_ptr[2]);
 
 		// Store the tile identifiers.
-		encode_uint16(E.value.cell.source_id, &cell_data_ptr[4]);
-		encode_uint16(E.value.cell.coord_x, &cell_data_ptr[6]);
-		encode_uint16(E.value.cell.coord_y, &cell_data_ptr[8]);
-		encode_uint16(E.value.cell.alternative_tile, &cell_data_ptr[10]);
+		encode_uint16(E->value.cell.source_id, &cell_data_ptr[4]);
+		encode_uint16(E->value.cell.coord_x, &cell_data_ptr[6]);
+		encode_uint16(E->value.cell.coord_y, &cell_data_ptr[8]);
+		encode_uint16(E->value.cell.alternative_tile, &cell_data_ptr[10]);
 
 		index += cell_data_struct_size;
 	}
@@ -3422,6 +3463,15 @@ int TileMapLayer::get_physics_quadrant_size() const {
 	return physics_quadrant_size;
 }
 
+void TileMapLayer::set_physics_quadrant_update_budget(int p_budget) {
+	ERR_FAIL_COND_MSG(p_budget < 0, "Physics quadrant update budget cannot be negative.");
+	physics_quadrant_update_budget = p_budget;
+}
+
+int TileMapLayer::get_physics_quadrant_update_budget() const {
+	return physics_quadrant_update_budget;
+}
+
 void TileMapLayer::set_occlusion_enabled(bool p_enabled) {
 	if (occlusion_enabled == p_enabled) {
 		return;
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/templates/paged_allocator.h"
 #include "scene/resources/2d/tile_set.h"
 
 #ifndef NAVIGATION_2D_DISABLED
@@ -170,6 +171,251 @@ struct CellData {
 	}
 };
 
+// Cells storage, grouping cells by square chunks of the map.
+// Each chunk only stores the cells it has, so sparse maps don't pay for empty cells.
+// Cells are allocated by pages, so cells painted together stay close in memory and are iterated chunk by chunk.
+class CellDataMap {
+public:
+	typedef KeyValue<Vector2i, CellData> Element;
+
+	static constexpr int CHUNK_SHIFT = 3;
+	static constexpr int CHUNK_SIZE = 1 << CHUNK_SHIFT;
+	static constexpr int CHUNK_MASK = CHUNK_SIZE - 1;
+	static constexpr int CHUNK_CELLS_COUNT = CHUNK_SIZE * CHUNK_SIZE;
+	static constexpr int CELLS_PAGE_SIZE = 64;
+
+private:
+	static_assert(CHUNK_CELLS_COUNT == 64, "Chunk occupancy must fit in 64 bits.");
+
+	struct Chunk {
+		Vector2i coords;
+		uint64_t occupancy = 0; // Bit `i` is set when the cell with index `i` in the chunk exists.
+		Chunk *prev = nullptr;
+		Chunk *next = nullptr;
+		LocalVector<Element *> cells; // Existing cells only, ordered by index in the chunk.
+	};
+
+	HashMap<Vector2i, Chunk *> chunks;
+	Chunk *first_chunk = nullptr;
+	Chunk *last_chunk = nullptr;
+	PagedAllocator<Element> cells_allocator = PagedAllocator<Element>(CELLS_PAGE_SIZE);
+	uint32_t cells_count = 0;
+
+	_FORCE_INLINE_ static Vector2i _get_chunk_coords(const Vector2i &p_coords) {
+		// Arithmetic shift, so negative coords are rounded down.
+		return Vector2i(p_coords.x >> CHUNK_SHIFT, p_coords.y >> CHUNK_SHIFT);
+	}
+
+	_FORCE_INLINE_ static uint32_t _get_index_in_chunk(const Vector2i &p_coords) {
+		return ((p_coords.y & CHUNK_MASK) << CHUNK_SHIFT) | (p_coords.x & CHUNK_MASK);
+	}
+
+	// Position of the cell with the given index in the chunk's cells array, i.e. the number of existing cells before it.
+	_FORCE_INLINE_ static uint32_t _get_cell_position(const Chunk *p_chunk, uint32_t p_index) {
+		uint64_t bits = p_chunk->occupancy & ((uint64_t(1) << p_index) - 1);
+		bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+		bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+		bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return (bits * 0x0101010101010101ULL) >> 56;
+	}
+
+	_FORCE_INLINE_ static bool _has_cell(const Chunk *p_chunk, uint32_t p_index) {
+		return (p_chunk->occupancy >> p_index) & 1;
+	}
+
+	_FORCE_INLINE_ Element *_get_element(const Vector2i &p_coords) const {
+		Chunk *const *chunk = chunks.getptr(_get_chunk_coords(p_coords));
+		if (!chunk) {
+			return nullptr;
+		}
+		uint32_t index = _get_index_in_chunk(p_coords);
+		return _has_cell(*chunk, index) ? (*chunk)->cells[_get_cell_position(*chunk, index)] : nullptr;
+	}
+
+	struct ElementCoordsComparator {
+		_FORCE_INLINE_ bool operator()(const Element *p_a, const Element *p_b) const {
+			return p_a->key < p_b->key;
+		}
+	};
+
+public:
+	template <typename T>
+	struct IteratorBase {
+		_FORCE_INLINE_ T &operator*() const {
+			return *chunk->cells[position];
+		}
+		_FORCE_INLINE_ T *operator->() const { return chunk->cells[position]; }
+		_FORCE_INLINE_ IteratorBase &operator++() {
+			// Chunks are never empty.
+			position++;
+			if (position >= chunk->cells.size()) {
+				chunk = chunk->next;
+				position = 0;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const IteratorBase &p_other) const { return chunk == p_other.chunk && position == p_other.position; }
+		_FORCE_INLINE_ bool operator!=(const IteratorBase &p_other) const { return !(*this == p_other); }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return chunk != nullptr;
+		}
+
+		_FORCE_INLINE_ IteratorBase(const Chunk *p_chunk, uint32_t p_position) :
+				chunk(p_chunk), position(p_position) {}
+		_FORCE_INLINE_ IteratorBase() {}
+
+	private:
+		const Chunk *chunk = nullptr;
+		uint32_t position = 0;
+	};
+
+	typedef IteratorBase<Element> Iterator;
+	typedef IteratorBase<const Element> ConstIterator;
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(first_chunk, 0);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator();
+	}
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(first_chunk, 0);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator();
+	}
+
+	Iterator find(const Vector2i &p_coords) {
+		Chunk **chunk = chunks.getptr(_get_chunk_coords(p_coords));
+		if (!chunk) {
+			return end();
+		}
+		uint32_t index = _get_index_in_chunk(p_coords);
+		return _has_cell(*chunk, index) ? Iterator(*chunk, _get_cell_position(*chunk, index)) : end();
+	}
+
+	ConstIterator find(const Vector2i &p_coords) const {
+		Chunk *const *chunk = chunks.getptr(_get_chunk_coords(p_coords));
+		if (!chunk) {
+			return end();
+		}
+		uint32_t index = _get_index_in_chunk(p_coords);
+		return _has_cell(*chunk, index) ? ConstIterator(*chunk, _get_cell_position(*chunk, index)) : end();
+	}
+
+	_FORCE_INLINE_ bool has(const Vector2i &p_coords) const {
+		return _get_element(p_coords) != nullptr;
+	}
+
+	Iterator insert(const Vector2i &p_coords, const CellData &p_cell_data) {
+		Vector2i chunk_coords = _get_chunk_coords(p_coords);
+		Chunk **chunk_ptr = chunks.getptr(chunk_coords);
+		Chunk *chunk;
+		if (chunk_ptr) {
+			chunk = *chunk_ptr;
+		} else {
+			chunk = memnew(Chunk);
+			chunk->coords = chunk_coords;
+			chunk->prev = last_chunk;
+			if (last_chunk) {
+				last_chunk->next = chunk;
+			} else {
+				first_chunk = chunk;
+			}
+			last_chunk = chunk;
+			chunks.insert(chunk_coords, chunk);
+		}
+
+		uint32_t index = _get_index_in_chunk(p_coords);
+		uint32_t position = _get_cell_position(chunk, index);
+		if (_has_cell(chunk, index)) {
+			chunk->cells[position]->value = p_cell_data;
+		} else {
+			chunk->cells.insert(position, cells_allocator.alloc(p_coords, p_cell_data));
+			chunk->occupancy |= uint64_t(1) << index;
+			cells_count++;
+		}
+		return Iterator(chunk, position);
+	}
+
+	bool erase(const Vector2i &p_coords) {
+		Chunk **chunk_ptr = chunks.getptr(_get_chunk_coords(p_coords));
+		if (!chunk_ptr) {
+			return false;
+		}
+		Chunk *chunk = *chunk_ptr;
+		uint32_t index = _get_index_in_chunk(p_coords);
+		if (!_has_cell(chunk, index)) {
+			return false;
+		}
+
+		uint32_t position = _get_cell_position(chunk, index);
+		cells_allocator.free(chunk->cells[position]);
+		chunk->cells.remove_at(position);
+		chunk->occupancy &= ~(uint64_t(1) << index);
+		cells_count--;
+
+		if (chunk->cells.is_empty()) {
+			if (chunk->prev) {
+				chunk->prev->next = chunk->next;
+			} else {
+				first_chunk = chunk->next;
+			}
+			if (chunk->next) {
+				chunk->next->prev = chunk->prev;
+			} else {
+				last_chunk = chunk->prev;
+			}
+			chunks.erase(chunk->coords);
+			memdelete(chunk);
+		}
+		if (cells_count == 0) {
+			// Give the pages back.
+			cells_allocator.reset();
+		}
+		return true;
+	}
+
+	void clear() {
+		Chunk *chunk = first_chunk;
+		while (chunk) {
+			for (Element *element : chunk->cells) {
+				cells_allocator.free(element);
+			}
+			Chunk *next = chunk->next;
+			memdelete(chunk);
+			chunk = next;
+		}
+		chunks.clear();
+		first_chunk = nullptr;
+		last_chunk = nullptr;
+		cells_count = 0;
+		cells_allocator.reset();
+	}
+
+	// Iteration follows chunks, use this when the order must not depend on how the cells were painted (e.g., when serializing).
+	void get_elements_sorted_by_coords(LocalVector<const Element *> &r_elements) const {
+		r_elements.clear();
+		r_elements.reserve(cells_count);
+		for (const Element &E : *this) {
+			r_elements.push_back(&E);
+		}
+		r_elements.sort_custom<ElementCoordsComparator>();
+	}
+
+	_FORCE_INLINE_ uint32_t size() const { return cells_count; }
+	_FORCE_INLINE_ bool is_empty() const { return cells_count == 0; }
+
+	CellDataMap() {}
+	CellDataMap(const CellDataMap &) = delete;
+	void operator=(const CellDataMap &) = delete;
+	~CellDataMap() {
+		clear();
+	}
+};
+
 // We use another comparator for Y-sorted layers with reversed X drawing order.
 struct CellDataYSortedXReversedComparator {
 	_FORCE_INLINE_ bool operator()(const CellData &p_a, const CellData &p_b) const {
@@ -297,6 +543,7 @@ public:
 	struct PhysicsBodyValue {
 		RID body;
 		Vector<Vector<Vector2>> polygons;
+		Vector<Vector<Vector2>> convex_polygons; // Result of merging polygons, before the shapes are created.
 	};
 
 	struct CoordsWorldComparator {
@@ -314,6 +561,7 @@ public:
 	SelfList<CellData>::List cells;
 
 	HashMap<PhysicsBodyKey, PhysicsBodyValue, PhysicsBodyKeyHasher> bodies;
+	HashMap<PhysicsBodyKey, PhysicsBodyValue, PhysicsBodyKeyHasher> rebuilt_bodies; // Replaces bodies once fully built.
 	LocalVector<Ref<ConvexPolygonShape2D>> shapes;
 
 	SelfList<PhysicsQuadrant> dirty_quadrant_list_element;
@@ -330,6 +578,7 @@ public:
 
 class TileMapLayer : public Node2D {
 	GDCLASS(TileMapLayer, Node2D);
+	friend class TestTileMapLayerInternalsAccessor;
 
 public:
 	enum HighlightMode {
@@ -385,7 +634,7 @@ private:
 	static constexpr float FP_ADJUST = 0.00001;
 
 	// Properties.
-	HashMap<Vector2i, CellData> tile_map_layer_data;
+	CellDataMap tile_map_layer_data;
 
 	bool enabled = true;
 	Ref<TileSet> tile_set;
@@ -399,6 +648,7 @@ private:
 	bool collision_enabled = true;
 	bool use_kinematic_bodies = false;
 	int physics_quadrant_size = 16;
+	int physics_quadrant_update_budget = 0;
 	DebugVisibilityMode collision_visibility_mode = DEBUG_VISIBILITY_MODE_DEFAULT;
 
 	bool occlusion_enabled = true;
@@ -463,8 +713,10 @@ private:
 #ifndef PHYSICS_2D_DISABLED
 	HashMap<Vector2i, Ref<PhysicsQuadrant>> physics_quadrant_map;
 	HashMap<RID, Vector2i> bodies_coords; // Mapping for RID to coords.
+	SelfList<PhysicsQuadrant>::List dirty_physics_quadrant_list; // Kept between updates when over the update budget.
 	bool _physics_was_cleaned_up = true;
 	void _physics_update(bool p_force_cleanup);
+	static void _physics_merge_body_polygons(void *p_userdata, uint32_t p_index);
 	void _physics_notification(int p_what);
 	void _physics_quadrants_update_cell(CellData &r_cell_data, SelfList<PhysicsQuadrant>::List &r_dirty_physics_quadrant_list);
 	void _physics_clear_cell(CellData &r_cell_data);
@@ -529,7 +781,7 @@ public:
 	int get_index_in_tile_map() const {
 		return layer_index_in_tile_map_node;
 	}
-	const HashMap<Vector2i, CellData> &get_tile_map_layer_data() const {
+	const CellDataMap &get_tile_map_layer_data() const {
 		return tile_map_layer_data;
 	}
 
@@ -629,6 +881,8 @@ public:
 	DebugVisibilityMode get_collision_visibility_mode() const;
 	void set_physics_quadrant_size(int p_size);
 	int get_physics_quadrant_size() const;
+	void set_physics_quadrant_update_budget(int p_budget);
+	int get_physics_quadrant_update_budget() const;
 
 	void set_occlusion_enabled(bool p_enabled);
 	bool is_occlusion_enabled() const;
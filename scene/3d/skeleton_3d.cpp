@@ -31,6 +31,8 @@
 #include "skeleton_3d.h"
 #include "skeleton_3d.compat.inc"
 
+#include "core/object/worker_thread_pool.h"
+
 #include "scene/3d/skeleton_modifier_3d.h"
 #if !defined(DISABLE_DEPRECATED) && !defined(PHYSICS_3D_DISABLED)
 #include "scene/3d/physics/physical_bone_simulator_3d.h"
@@ -309,7 +311,11 @@ void Skeleton3D::_notification(int p_what) {
 		} break;
 #endif // TOOLS_ENABLED
 		case NOTIFICATION_UPDATE_SKELETON: {
-			// Update bone transforms to apply unprocessed poses.
+			// Calculate global poses of all queued skeletons at once, then apply unprocessed poses.
+			// Each skeleton still finishes its own update and emits its signals in its own notification.
+			if (pose_update_queued) {
+				_process_pose_update_queue();
+			}
 			force_update_all_dirty_bones();
 
 			updating = true;
@@ -318,6 +324,7 @@ void Skeleton3D::_notification(int p_what) {
 			int len = bones.size();
 
 			LocalVector<bool> bone_global_pose_dirty_backup;
+			LocalVector<Transform3D> bone_global_poses_backup;
 
 			// Process modifiers.
 
@@ -329,8 +336,9 @@ void Skeleton3D::_notification(int p_what) {
 				for (uint32_t i = 0; i < bones.size(); i++) {
 					bones_backup[i].save(bonesptr[i]);
 				}
-				// Store dirty flags for global bone poses.
+				// Store dirty flags and global bone poses.
 				bone_global_pose_dirty_backup = bone_global_pose_dirty;
+				bone_global_poses_backup = bone_global_poses;
 
 				if (update_flags & UPDATE_FLAG_MODIFIER) {
 					_process_modifiers();
@@ -399,7 +407,7 @@ void Skeleton3D::_notification(int p_what) {
 				for (uint32_t i = 0; i < bind_count; i++) {
 					uint32_t bone_index = E->skin_bone_indices_ptrs[i];
 					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					rs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].global_pose * skin->get_bind_pose(i));
+					rs->skeleton_bone_set_transform(skeleton, i, bone_global_poses[bonesptr[bone_index].nested_set_offset] * skin->get_bind_pose(i));
 				}
 			}
 
@@ -408,8 +416,9 @@ void Skeleton3D::_notification(int p_what) {
 				for (uint32_t i = 0; i < bones.size(); i++) {
 					bones_backup[i].restore(bones[i]);
 				}
-				// Restore dirty flags for global bone poses.
+				// Restore dirty flags and global bone poses.
 				bone_global_pose_dirty = bone_global_pose_dirty_backup;
+				bone_global_poses = bone_global_poses_backup;
 			}
 
 			updating = false;
@@ -465,12 +474,20 @@ void Skeleton3D::_make_modifiers_dirty() {
 void Skeleton3D::_update_bones_nested_set() const {
 	nested_set_offset_to_bone_index.resize(bones.size());
 	bone_global_pose_dirty.resize(bones.size());
+	nested_set_parent_offsets.resize(bones.size());
+	bone_local_poses.resize(bones.size());
+	bone_global_poses.resize(bones.size());
 	_make_bone_global_poses_dirty();
 
 	int offset = 0;
 	for (int bone : parentless_bones) {
 		offset += _update_bone_nested_set(bone, offset);
 	}
+
+	for (uint32_t i = 0; i < nested_set_parent_offsets.size(); i++) {
+		int parent = bones[nested_set_offset_to_bone_index[i]].parent;
+		nested_set_parent_offsets[i] = parent >= 0 ? bones[parent].nested_set_offset : -1;
+	}
 }
 
 int Skeleton3D::_update_bone_nested_set(int p_bone, int p_offset) const {
@@ -528,25 +545,25 @@ void Skeleton3D::_update_bone_global_pose(int p_bone) const {
 		return;
 	}
 
-	thread_local LocalVector<int> bone_list;
-	bone_list.clear();
+	thread_local LocalVector<int> offset_list;
+	offset_list.clear();
 	Transform3D global_pose;
 
 	// Create list of parent bones for which the global pose needs to be recalculated.
-	for (int bone = p_bone; bone >= 0; bone = bones[bone].parent) {
-		int offset = bones[bone].nested_set_offset;
+	for (int offset = nested_set_offset; offset >= 0; offset = nested_set_parent_offsets[offset]) {
 		// Stop searching when global pose is not dirty.
 		if (!bone_global_pose_dirty[offset]) {
-			global_pose = bones[bone].global_pose;
+			global_pose = bone_global_poses[offset];
 			break;
 		}
 
-		bone_list.push_back(bone);
+		offset_list.push_back(offset);
 	}
 
 	// Calculate global poses for all parent bones and the current bone.
-	for (int i = bone_list.size() - 1; i >= 0; i--) {
-		int bone_idx = bone_list[i];
+	for (int i = offset_list.size() - 1; i >= 0; i--) {
+		int offset = offset_list[i];
+		int bone_idx = nested_set_offset_to_bone_index[offset];
 		Bone &bone = bones[bone_idx];
 		bool bone_enabled = bone.enabled && !show_rest_only;
 		Transform3D bone_pose = bone_enabled ? get_bone_pose(bone_idx) : get_bone_rest(bone_idx);
@@ -558,8 +575,8 @@ void Skeleton3D::_update_bone_global_pose(int p_bone) const {
 		}
 #endif // _DISABLE_DEPRECATED
 
-		bone.global_pose = global_pose;
-		bone_global_pose_dirty[bone.nested_set_offset] = false;
+		bone_global_poses[offset] = global_pose;
+		bone_global_pose_dirty[offset] = false;
 	}
 }
 
@@ -567,7 +584,7 @@ Transform3D Skeleton3D::get_bone_global_pose(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Transform3D());
 	_update_bone_global_pose(p_bone);
-	return bones[p_bone].global_pose;
+	return bone_global_poses[bones[p_bone].nested_set_offset];
 }
 
 void Skeleton3D::set_bone_global_pose(int p_bone, const Transform3D &p_pose) {
@@ -831,6 +848,9 @@ void Skeleton3D::clear_bones() {
 	bone_global_pose_dirty.clear();
 	parentless_bones.clear();
 	nested_set_offset_to_bone_index.clear();
+	nested_set_parent_offsets.clear();
+	bone_local_poses.clear();
+	bone_global_poses.clear();
 
 	process_order_dirty = true;
 	version++;
@@ -945,6 +965,7 @@ void Skeleton3D::_update_deferred(UpdateFlag p_update_flag) {
 #endif //TOOLS_ENABLED
 		if (update_flags == UPDATE_FLAG_NONE && !updating) {
 			notify_deferred_thread_group(NOTIFICATION_UPDATE_SKELETON); // It must never be called more than once in a single frame.
+			_queue_pose_update();
 		}
 		update_flags |= p_update_flag;
 	}
@@ -1061,9 +1082,7 @@ void Skeleton3D::force_update_all_bone_transforms() {
 
 void Skeleton3D::_force_update_all_bone_transforms() const {
 	_update_process_order();
-	for (int i = 0; i < parentless_bones.size(); i++) {
-		_force_update_bone_children_transforms(parentless_bones[i]);
-	}
+	_update_bone_global_poses();
 	if (rest_dirty) {
 		rest_dirty = false;
 		const_cast<Skeleton3D *>(this)->emit_signal(SNAME("rest_updated"));
@@ -1086,67 +1105,144 @@ void Skeleton3D::_force_update_bone_children_transforms(int p_bone_idx) const {
 	ERR_FAIL_INDEX(p_bone_idx, bone_size);
 
 	_update_process_order();
+	_update_bone_global_poses();
+}
 
+void Skeleton3D::_update_bone_global_poses() const {
+	// Must not emit signals or touch other nodes, since this may run on a worker thread.
+	const int bone_size = bones.size();
 	Bone *bonesptr = bones.ptr();
-
-	// Loop through nested set.
+	const int *offset_to_bone_index = nested_set_offset_to_bone_index.ptr();
+	bool *global_pose_dirty = bone_global_pose_dirty.ptr();
+	Transform3D *local_poses = bone_local_poses.ptr();
+	Transform3D *global_poses = bone_global_poses.ptr();
+	const int *parent_offsets = nested_set_parent_offsets.ptr();
+
+	// Gather local poses of dirty bones in nested set order.
+	bool any_dirty = false;
 	for (int offset = 0; offset < bone_size; offset++) {
+		Bone &b = bonesptr[offset_to_bone_index[offset]];
 		if (rest_dirty) {
-			int current_bone_idx = nested_set_offset_to_bone_index[offset];
-			Bone &b = bonesptr[current_bone_idx];
 			b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest; // Rest needs update apert from pose.
 		}
 
-		if (!bone_global_pose_dirty[offset]) {
+		if (!global_pose_dirty[offset]) {
 			continue;
 		}
 
-		int current_bone_idx = nested_set_offset_to_bone_index[offset];
-		Bone &b = bonesptr[current_bone_idx];
-		bool bone_enabled = b.enabled && !show_rest_only;
-
-		if (bone_enabled) {
+		if (b.enabled && !show_rest_only) {
 			b.update_pose_cache();
-			Transform3D pose = b.pose_cache;
-
-			if (b.parent >= 0) {
-				b.global_pose = bonesptr[b.parent].global_pose * pose;
-			} else {
-				b.global_pose = pose;
-			}
+			local_poses[offset] = b.pose_cache;
 		} else {
-			if (b.parent >= 0) {
-				b.global_pose = bonesptr[b.parent].global_pose * b.rest;
-			} else {
-				b.global_pose = b.rest;
-			}
+			local_poses[offset] = b.rest;
 		}
+		any_dirty = true;
+	}
+
+	if (!any_dirty) {
+		return;
+	}
 
 #ifndef DISABLE_DEPRECATED
-		if (bone_enabled) {
-			Transform3D pose = b.pose_cache;
-			if (b.parent >= 0) {
-				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * pose;
-			} else {
-				b.pose_global_no_override = pose;
+	if (global_pose_override_used) {
+		// Overridden global poses are inherited by children, so apply them while walking the hierarchy.
+		for (int offset = 0; offset < bone_size; offset++) {
+			if (!global_pose_dirty[offset]) {
+				continue;
 			}
-		} else {
-			if (b.parent >= 0) {
-				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * b.rest;
+
+			Bone &b = bonesptr[offset_to_bone_index[offset]];
+			int parent_offset = parent_offsets[offset];
+			if (parent_offset >= 0) {
+				b.pose_global_no_override = bonesptr[offset_to_bone_index[parent_offset]].pose_global_no_override * local_poses[offset];
+				global_poses[offset] = global_poses[parent_offset] * local_poses[offset];
 			} else {
-				b.pose_global_no_override = b.rest;
+				b.pose_global_no_override = local_poses[offset];
+				global_poses[offset] = local_poses[offset];
 			}
+			if (b.global_pose_override_amount >= CMP_EPSILON) {
+				global_poses[offset] = global_poses[offset].interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+			}
+			if (b.global_pose_override_reset) {
+				b.global_pose_override_amount = 0.0;
+			}
+			global_pose_dirty[offset] = false;
 		}
-		if (b.global_pose_override_amount >= CMP_EPSILON) {
-			b.global_pose = b.global_pose.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
-		}
-		if (b.global_pose_override_reset) {
-			b.global_pose_override_amount = 0.0;
+		return;
+	}
+#endif // _DISABLE_DEPRECATED
+
+	// Parents always precede their children in the nested set, so a single linear pass is enough.
+	for (int offset = 0; offset < bone_size; offset++) {
+		if (!global_pose_dirty[offset]) {
+			continue;
 		}
+
+		int parent_offset = parent_offsets[offset];
+		global_poses[offset] = parent_offset >= 0 ? global_poses[parent_offset] * local_poses[offset] : local_poses[offset];
+		global_pose_dirty[offset] = false;
+	}
+
+#ifndef DISABLE_DEPRECATED
+	for (int offset = 0; offset < bone_size; offset++) {
+		bonesptr[offset_to_bone_index[offset]].pose_global_no_override = global_poses[offset];
+	}
 #endif // _DISABLE_DEPRECATED
+}
 
-		bone_global_pose_dirty[offset] = false;
+void Skeleton3D::_queue_pose_update() {
+	// Other process thread groups may be running, only batch skeletons updated from the main thread.
+	if (pose_update_queued || !Thread::is_main_thread() || is_group_processing()) {
+		return;
 	}
+	pose_update_queue.push_back(get_instance_id());
+	pose_update_queued = true;
+}
+
+void Skeleton3D::_update_bone_global_poses_task(void *p_userdata, uint32_t p_index) {
+	LocalVector<Skeleton3D *> &skeletons = *(LocalVector<Skeleton3D *> *)p_userdata;
+	skeletons[p_index]->_update_bone_global_poses();
+}
+
+void Skeleton3D::_process_pose_update_queue() {
+	if (!Thread::is_main_thread() || is_group_processing()) {
+		return;
+	}
+
+	LocalVector<ObjectID> queue = pose_update_queue;
+	pose_update_queue.clear();
+	for (const ObjectID &id : queue) {
+		Skeleton3D *skeleton = ObjectDB::get_instance<Skeleton3D>(id);
+		if (skeleton) {
+			skeleton->pose_update_queued = false;
+		}
+	}
+
+	// Rebuilding the process order emits signals, so it stays on the main thread and is done for every skeleton first.
+	// Handlers may free skeletons or change their bones, so they are looked up again afterwards.
+	for (const ObjectID &id : queue) {
+		Skeleton3D *skeleton = ObjectDB::get_instance<Skeleton3D>(id);
+		if (skeleton && skeleton->dirty && skeleton->is_inside_tree()) {
+			skeleton->_update_process_order();
+		}
+	}
+
+	// Skeletons whose bones changed again are left to their own update notification.
+	LocalVector<Skeleton3D *> skeletons;
+	for (const ObjectID &id : queue) {
+		Skeleton3D *skeleton = ObjectDB::get_instance<Skeleton3D>(id);
+		if (skeleton && skeleton->dirty && skeleton->is_inside_tree() && !skeleton->process_order_dirty) {
+			skeletons.push_back(skeleton);
+		}
+	}
+
+	if (skeletons.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_update_bone_global_poses_task, &skeletons, skeletons.size(), -1, true, SNAME("Skeleton3DUpdateBoneGlobalPoses"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (skeletons.size() == 1) {
+		_update_bone_global_poses_task(&skeletons, 0);
+	}
+	// The skeletons stay dirty, so their own update notification emits their signals, in their usual order.
 }
 
 void Skeleton3D::_find_modifiers() {
@@ -1344,6 +1440,9 @@ void Skeleton3D::set_bone_global_pose_override(int p_bone, const Transform3D &p_
 	bones[p_bone].global_pose_override_amount = p_amount;
 	bones[p_bone].global_pose_override = p_pose;
 	bones[p_bone].global_pose_override_reset = !p_persistent;
+	if (p_amount >= CMP_EPSILON) {
+		global_pose_override_used = true;
+	}
 	_make_dirty();
 	_make_bone_global_pose_subtree_dirty(p_bone);
 }
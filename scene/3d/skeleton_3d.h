@@ -111,7 +111,6 @@ private:
 		Vector3 pose_position;
 		Quaternion pose_rotation;
 		Vector3 pose_scale = Vector3(1, 1, 1);
-		Transform3D global_pose;
 		int nested_set_offset = 0; // Offset in nested set of bone hierarchy.
 		int nested_set_span = 0; // Subtree span in nested set of bone hierarchy.
 
@@ -138,14 +137,12 @@ private:
 		Vector3 pose_position;
 		Quaternion pose_rotation;
 		Vector3 pose_scale = Vector3(1, 1, 1);
-		Transform3D global_pose;
 
 		void save(const Bone &p_bone) {
 			pose_cache = p_bone.pose_cache;
 			pose_position = p_bone.pose_position;
 			pose_rotation = p_bone.pose_rotation;
 			pose_scale = p_bone.pose_scale;
-			global_pose = p_bone.global_pose;
 		}
 
 		void restore(Bone &r_bone) {
@@ -153,7 +150,6 @@ private:
 			r_bone.pose_position = pose_position;
 			r_bone.pose_rotation = pose_rotation;
 			r_bone.pose_scale = pose_scale;
-			r_bone.global_pose = global_pose;
 		}
 	};
 
@@ -192,13 +188,26 @@ private:
 	// Global bone pose calculation.
 	mutable LocalVector<int> nested_set_offset_to_bone_index; // Map from Bone::nested_set_offset to bone index.
 	mutable LocalVector<bool> bone_global_pose_dirty; // Indexable with Bone::nested_set_offset.
+	mutable LocalVector<int> nested_set_parent_offsets; // Parent offset of each offset in nested set, parents always come first. -1 if parentless.
+	mutable LocalVector<Transform3D> bone_local_poses; // Indexable with Bone::nested_set_offset.
+	mutable LocalVector<Transform3D> bone_global_poses; // Indexable with Bone::nested_set_offset.
 	void _update_bones_nested_set() const;
 	int _update_bone_nested_set(int p_bone, int p_offset) const;
 	void _make_bone_global_poses_dirty() const;
 	void _make_bone_global_pose_subtree_dirty(int p_bone) const;
 	void _update_bone_global_pose(int p_bone) const;
+	void _update_bone_global_poses() const;
+
+	// Global poses of all skeletons updated in the same frame are calculated in a single group task.
+	bool pose_update_queued = false;
+	static inline LocalVector<ObjectID> pose_update_queue;
+	void _queue_pose_update();
+	static void _update_bone_global_poses_task(void *p_userdata, uint32_t p_index);
+	static void _process_pose_update_queue();
 
 #ifndef DISABLE_DEPRECATED
+	mutable bool global_pose_override_used = false;
+
 	void _add_bone_bind_compat_88791(const String &p_name);
 
 	static void _bind_compatibility_methods();
@@ -33,6 +33,7 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/string_name.h"
 #include "scene/2d/audio_stream_player_2d.h"
 #include "scene/animation/animation_player.h"
@@ -570,6 +571,7 @@ void AnimationMixer::_clear_caches() {
 	}
 	track_cache.clear();
 	animation_track_num_to_track_cache.clear();
+	animation_compressed_track_cursors.clear();
 	cache_valid = false;
 	capture_cache.clear();
 
@@ -992,6 +994,133 @@ void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
 	clear_animation_instances();
 }
 
+void AnimationMixer::_queue_process_animation(double p_delta) {
+	// Other process thread groups may be running, only batch mixers processed from the main thread.
+	if (!threaded_blending || !Thread::is_main_thread() || is_group_processing()) {
+		_process_animation(p_delta);
+		return;
+	}
+
+	if (threaded_blending_queued) {
+		threaded_blending_delta += p_delta;
+		return;
+	}
+
+	// Process all mixers queued this frame together once the tree is done processing nodes.
+	if (threaded_blending_queue.is_empty()) {
+		callable_mp_static(&AnimationMixer::_process_threaded_blending_queue).call_deferred();
+	}
+	threaded_blending_queue.push_back(get_instance_id());
+	threaded_blending_queued = true;
+	threaded_blending_delta = p_delta;
+}
+
+void AnimationMixer::_blend_process_threaded_task(void *p_userdata, uint32_t p_index) {
+	AnimationMixer *mixer = (*(LocalVector<AnimationMixer *> *)p_userdata)[p_index];
+	mixer->_blend_process(mixer->threaded_blending_delta, false, BLEND_TRACKS_THREAD_SAFE);
+}
+
+AnimationMixer *AnimationMixer::_get_threaded_blending_mixer(ObjectID p_id) {
+	// Scripts run between the phases of the batch may have freed mixers or removed them from the tree.
+	AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(p_id);
+	if (!mixer) {
+		return nullptr;
+	}
+	if (!mixer->is_inside_tree()) {
+		mixer->threaded_blending_sampled = false;
+		mixer->clear_animation_instances();
+		return nullptr;
+	}
+	return mixer;
+}
+
+void AnimationMixer::_process_threaded_blending_queue() {
+	LocalVector<ObjectID> queue = threaded_blending_queue;
+	threaded_blending_queue.clear();
+	for (const ObjectID &id : queue) {
+		AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(id);
+		if (mixer) {
+			mixer->threaded_blending_queued = false;
+		}
+	}
+
+	// Playback, state machines and captures can run scripts and emit signals, so they stay on the main thread.
+	// Mixers are kept by ID, and looked up again before each phase.
+	LocalVector<ObjectID> blending;
+	LocalVector<ObjectID> threaded;
+	for (const ObjectID &id : queue) {
+		AnimationMixer *mixer = _get_threaded_blending_mixer(id);
+		if (!mixer || !mixer->active) {
+			continue;
+		}
+		const double delta = mixer->threaded_blending_delta;
+		mixer->_blend_init();
+		if (!mixer->_blend_pre_process(delta, mixer->track_count, mixer->track_map)) {
+			mixer->clear_animation_instances();
+			continue;
+		}
+		mixer->_blend_capture(delta);
+		mixer->_blend_calc_total_weight();
+		blending.push_back(id);
+
+		// Key values post-processed by scripts are blended on the main thread as well.
+		if (!GDVIRTUAL_IS_OVERRIDDEN_PTR(mixer, _post_process_key_value)) {
+			mixer->is_GDVIRTUAL_CALL_post_process_key_value = false;
+			mixer->threaded_blending_sampled = true;
+			threaded.push_back(id);
+		}
+	}
+
+	// No scripts run during the threaded pass, so the mixers can't go away while it runs.
+	LocalVector<AnimationMixer *> threaded_mixers;
+	for (const ObjectID &id : threaded) {
+		AnimationMixer *mixer = _get_threaded_blending_mixer(id);
+		if (mixer) {
+			threaded_mixers.push_back(mixer);
+		}
+	}
+	if (threaded_mixers.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_blend_process_threaded_task, &threaded_mixers, threaded_mixers.size(), -1, true, SNAME("AnimationMixerBlend"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (threaded_mixers.size() == 1) {
+		_blend_process_threaded_task(&threaded_mixers, 0);
+	}
+	threaded_mixers.clear();
+
+	// Tracks calling into other objects, and applying the results to them, happen on the main thread.
+	for (const ObjectID &id : blending) {
+		AnimationMixer *mixer = _get_threaded_blending_mixer(id);
+		if (!mixer) {
+			continue;
+		}
+		mixer->_blend_process(mixer->threaded_blending_delta, false, mixer->threaded_blending_sampled ? BLEND_TRACKS_MAIN_THREAD : BLEND_TRACKS_ALL);
+		mixer->threaded_blending_sampled = false;
+		mixer->_blend_apply();
+		mixer->_blend_post_process();
+		mixer->emit_signal(SNAME("mixer_applied"));
+		mixer->clear_animation_instances();
+	}
+}
+
+bool AnimationMixer::_is_track_thread_safe(const Ref<Animation> &p_anim, int p_track, Animation::TrackType p_type) const {
+	switch (p_type) {
+		case Animation::TYPE_POSITION_3D:
+		case Animation::TYPE_ROTATION_3D:
+		case Animation::TYPE_SCALE_3D:
+		case Animation::TYPE_BLEND_SHAPE:
+		case Animation::TYPE_BEZIER: {
+			return true;
+		}
+		case Animation::TYPE_VALUE: {
+			// Discrete keys are set on the object right away.
+			return p_anim->value_track_get_update_mode(p_track) != Animation::UPDATE_DISCRETE || callback_mode_discrete == ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
 Variant AnimationMixer::_post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant &p_value, ObjectID p_object_id, int p_object_sub_idx) {
 #ifndef _3D_DISABLED
 	switch (p_anim->track_get_type(p_track)) {
@@ -1100,6 +1229,7 @@ void AnimationMixer::blend_capture(double p_delta) {
 	if (Animation::is_less_or_equal_approx(capture_cache.remain, 0)) {
 		if (capture_cache.animation.is_valid()) {
 			animation_track_num_to_track_cache.erase(capture_cache.animation);
+			animation_compressed_track_cursors.erase(capture_cache.animation);
 		}
 		capture_cache.clear();
 		return;
@@ -1161,7 +1291,7 @@ void AnimationMixer::_blend_calc_total_weight() {
 	}
 }
 
-void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
+void AnimationMixer::_blend_process(double p_delta, bool p_update_only, BlendTracks p_tracks) {
 	// Apply value/transform/blend/bezier blends to track caches and execute method/audio/animation tracks.
 #ifdef TOOLS_ENABLED
 	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
@@ -1189,6 +1319,38 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 		Animation::Track *const *tracks_ptr = tracks.ptr();
 		real_t a_length = a->get_length();
 		int count = tracks.size();
+		// Sample the compressed tracks in one go, resuming from where the previous frame found their keys.
+		// Tracks that are disabled, missing from the cache, filtered out, or left to the other pass are not decoded.
+		const Animation::CompressedTrackSample *compressed_samples = nullptr;
+		if (p_tracks != BLEND_TRACKS_MAIN_THREAD && !Math::is_zero_approx(weight) && a->is_compressed()) {
+			compressed_track_mask.resize(count);
+			bool any_needed = false;
+			for (int i = 0; i < count; i++) {
+				const Animation::Track *animation_track = tracks_ptr[i];
+				bool needed = false;
+				switch (animation_track->type) {
+					case Animation::TYPE_POSITION_3D:
+					case Animation::TYPE_ROTATION_3D:
+					case Animation::TYPE_SCALE_3D:
+					case Animation::TYPE_BLEND_SHAPE: {
+						const TrackCache *track = track_num_to_track_cache[i];
+						if (!animation_track->enabled || track == nullptr || track->blend_idx < 0 || track->blend_idx >= track_count) {
+							break;
+						}
+						real_t blend = track->blend_idx < track_weights_count ? track_weights_ptr[track->blend_idx] * weight : weight;
+						needed = !Math::is_zero_approx(blend) && (deterministic || !Math::is_zero_approx(track->total_weight)) &&
+								(p_tracks == BLEND_TRACKS_ALL || (p_tracks == BLEND_TRACKS_THREAD_SAFE) == _is_track_thread_safe(a, i, animation_track->type));
+					} break;
+					default: {
+					} break;
+				}
+				compressed_track_mask[i] = needed;
+				any_needed = any_needed || needed;
+			}
+			if (any_needed && a->sample_compressed_tracks(time, compressed_track_samples, animation_compressed_track_cursors[a], compressed_track_mask.ptr())) {
+				compressed_samples = compressed_track_samples.ptr();
+			}
+		}
 		for (int i = 0; i < count; i++) {
 			const Animation::Track *animation_track = tracks_ptr[i];
 			if (!animation_track->enabled) {
@@ -1210,6 +1372,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 				blend = blend / track->total_weight;
 			}
 			Animation::TrackType ttype = animation_track->type;
+			if (p_tracks != BLEND_TRACKS_ALL && (p_tracks == BLEND_TRACKS_THREAD_SAFE) != _is_track_thread_safe(a, i, ttype)) {
+				continue;
+			}
 			track->root_motion = root_motion_track == animation_track->path;
 			switch (ttype) {
 				case Animation::TYPE_POSITION_3D: {
@@ -1346,9 +1511,13 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 loc;
-						Error err = a->try_position_track_interpolate(i, time, &loc);
-						if (err != OK) {
-							continue;
+						if (compressed_samples && compressed_samples[i].valid) {
+							loc = compressed_samples[i].value;
+						} else {
+							Error err = a->try_position_track_interpolate(i, time, &loc);
+							if (err != OK) {
+								continue;
+							}
 						}
 						loc = post_process_key_value(a, i, loc, t->object_id, t->bone_idx);
 						t->loc += (loc - t->init_loc) * blend;
@@ -1434,9 +1603,13 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Quaternion rot;
-						Error err = a->try_rotation_track_interpolate(i, time, &rot);
-						if (err != OK) {
-							continue;
+						if (compressed_samples && compressed_samples[i].valid) {
+							rot = compressed_samples[i].rotation;
+						} else {
+							Error err = a->try_rotation_track_interpolate(i, time, &rot);
+							if (err != OK) {
+								continue;
+							}
 						}
 						rot = post_process_key_value(a, i, rot, t->object_id, t->bone_idx);
 						t->rot = (t->rot * Quaternion().slerp(t->init_rot.inverse() * rot, blend)).normalized();
@@ -1522,9 +1695,13 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 scale;
-						Error err = a->try_scale_track_interpolate(i, time, &scale);
-						if (err != OK) {
-							continue;
+						if (compressed_samples && compressed_samples[i].valid) {
+							scale = compressed_samples[i].value;
+						} else {
+							Error err = a->try_scale_track_interpolate(i, time, &scale);
+							if (err != OK) {
+								continue;
+							}
 						}
 						scale = post_process_key_value(a, i, scale, t->object_id, t->bone_idx);
 						t->scale += (scale - t->init_scale) * blend;
@@ -1538,10 +1715,14 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 					float value;
-					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
-					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
-					if (err != OK) {
-						continue;
+					if (compressed_samples && compressed_samples[i].valid) {
+						value = compressed_samples[i].value.x;
+					} else {
+						Error err = a->try_blend_shape_track_interpolate(i, time, &value);
+						//ERR_CONTINUE(err!=OK); //used for testing, should be removed
+						if (err != OK) {
+							continue;
+						}
 					}
 					value = post_process_key_value(a, i, value, t->object_id, t->shape_index);
 					t->value += (value - t->init_value) * blend;
@@ -1843,7 +2024,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 			}
 		}
 	}
-	is_GDVIRTUAL_CALL_post_process_key_value = true;
+	if (p_tracks != BLEND_TRACKS_THREAD_SAFE) {
+		is_GDVIRTUAL_CALL_post_process_key_value = true;
+	}
 }
 
 void AnimationMixer::_blend_apply() {
@@ -2104,6 +2287,18 @@ Vector3 AnimationMixer::get_root_motion_scale_accumulator() const {
 	return root_motion_scale_accumulator;
 }
 
+/* -------------------------------------------- */
+/* -- Threaded blending ----------------------- */
+/* -------------------------------------------- */
+
+void AnimationMixer::set_threaded_blending_enabled(bool p_enabled) {
+	threaded_blending = p_enabled;
+}
+
+bool AnimationMixer::is_threaded_blending_enabled() const {
+	return threaded_blending;
+}
+
 /* -------------------------------------------- */
 /* -- Reset on save --------------------------- */
 /* -------------------------------------------- */
@@ -2299,6 +2494,7 @@ void AnimationMixer::capture(const StringName &p_name, double p_duration, Tween:
 	capture_cache.ease_type = p_ease_type;
 	if (capture_cache.animation.is_valid()) {
 		animation_track_num_to_track_cache.erase(capture_cache.animation);
+		animation_compressed_track_cursors.erase(capture_cache.animation);
 	}
 	capture_cache.animation.instantiate();
 
@@ -2348,13 +2544,13 @@ void AnimationMixer::_notification(int p_what) {
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE) {
-				_process_animation(get_process_delta_time());
+				_queue_process_animation(get_process_delta_time());
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS) {
-				_process_animation(get_physics_process_delta_time());
+				_queue_process_animation(get_physics_process_delta_time());
 			}
 		} break;
 
@@ -2443,6 +2639,10 @@ void AnimationMixer::_bind_methods() {
 	/* ---- Capture feature ---- */
 	ClassDB::bind_method(D_METHOD("capture", "name", "duration", "trans_type", "ease_type"), &AnimationMixer::capture, DEFVAL(Tween::TRANS_LINEAR), DEFVAL(Tween::EASE_IN));
 
+	/* ---- Threaded blending ---- */
+	ClassDB::bind_method(D_METHOD("set_threaded_blending_enabled", "enabled"), &AnimationMixer::set_threaded_blending_enabled);
+	ClassDB::bind_method(D_METHOD("is_threaded_blending_enabled"), &AnimationMixer::is_threaded_blending_enabled);
+
 	/* ---- Reset on save ---- */
 	ClassDB::bind_method(D_METHOD("set_reset_on_save_enabled", "enabled"), &AnimationMixer::set_reset_on_save_enabled);
 	ClassDB::bind_method(D_METHOD("is_reset_on_save_enabled"), &AnimationMixer::is_reset_on_save_enabled);
@@ -2451,6 +2651,7 @@ void AnimationMixer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "deterministic"), "set_deterministic", "is_deterministic");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "reset_on_save", PROPERTY_HINT_NONE, ""), "set_reset_on_save_enabled", "is_reset_on_save_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_node"), "set_root_node", "get_root_node");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded_blending"), "set_threaded_blending_enabled", "is_threaded_blending_enabled");
 
 	ADD_GROUP("Root Motion", "root_motion_");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_motion_track"), "set_root_motion_track", "get_root_motion_track");
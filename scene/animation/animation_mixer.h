@@ -50,6 +50,18 @@ class AnimationMixer : public Node {
 	bool reset_on_save = true;
 	bool is_GDVIRTUAL_CALL_post_process_key_value = true;
 
+	/* ---- Threaded blending ---- */
+	bool threaded_blending = false;
+	bool threaded_blending_queued = false;
+	bool threaded_blending_sampled = false; // Thread-safe tracks were already blended in the threaded pass.
+	double threaded_blending_delta = 0.0;
+	static inline LocalVector<ObjectID> threaded_blending_queue;
+
+	static AnimationMixer *_get_threaded_blending_mixer(ObjectID p_id);
+	static void _process_threaded_blending_queue();
+	static void _blend_process_threaded_task(void *p_userdata, uint32_t p_index);
+	void _queue_process_animation(double p_delta);
+
 public:
 	enum AnimationCallbackModeProcess {
 		ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS,
@@ -306,6 +318,9 @@ protected:
 	RootMotionCache root_motion_cache;
 	AHashMap<Animation::TypeHash, TrackCache *, HashHasher> track_cache;
 	AHashMap<Ref<Animation>, LocalVector<TrackCache *>> animation_track_num_to_track_cache;
+	AHashMap<Ref<Animation>, LocalVector<Animation::CompressedTrackCursor>> animation_compressed_track_cursors;
+	LocalVector<Animation::CompressedTrackSample> compressed_track_samples;
+	LocalVector<bool> compressed_track_mask;
 	HashSet<TrackCache *> playing_caches;
 	Vector<Node *> playing_audio_stream_players;
 
@@ -367,7 +382,14 @@ protected:
 	virtual bool _blend_pre_process(double p_delta, int p_track_count, const AHashMap<NodePath, int> &p_track_map);
 	virtual void _blend_capture(double p_delta);
 	void _blend_calc_total_weight(); // For indeterministic blending.
-	void _blend_process(double p_delta, bool p_update_only = false);
+
+	enum BlendTracks {
+		BLEND_TRACKS_ALL,
+		BLEND_TRACKS_THREAD_SAFE, // Only write to the track caches of this mixer, so mixers can blend them in parallel.
+		BLEND_TRACKS_MAIN_THREAD, // Call into other objects.
+	};
+	bool _is_track_thread_safe(const Ref<Animation> &p_anim, int p_track, Animation::TrackType p_type) const;
+	void _blend_process(double p_delta, bool p_update_only = false, BlendTracks p_tracks = BLEND_TRACKS_ALL);
 	void _blend_apply();
 	virtual void _blend_post_process();
 	void _call_object(ObjectID p_object_id, const StringName &p_method, const Vector<Variant> &p_params, bool p_deferred);
@@ -462,6 +484,10 @@ public:
 	/* ---- Capture feature ---- */
 	void capture(const StringName &p_name, double p_duration, Tween::TransitionType p_trans_type = Tween::TRANS_LINEAR, Tween::EaseType p_ease_type = Tween::EASE_IN);
 
+	/* ---- Threaded blending ---- */
+	void set_threaded_blending_enabled(bool p_enabled);
+	bool is_threaded_blending_enabled() const;
+
 	/* ---- Reset on save ---- */
 	void set_reset_on_save_enabled(bool p_enabled);
 	bool is_reset_on_save_enabled() const;
@@ -1185,6 +1185,51 @@ Error Animation::position_track_get_key(int p_track, int p_key, Vector3 *r_posit
 	return OK;
 }
 
+bool Animation::sample_compressed_tracks(double p_time, LocalVector<CompressedTrackSample> &r_samples, LocalVector<CompressedTrackCursor> &r_cursors, const bool *p_track_mask) const {
+	if (!compression.enabled) {
+		return false;
+	}
+
+	r_samples.resize(tracks.size());
+	r_cursors.resize(tracks.size());
+
+	Track *const *tracks_ptr = tracks.ptr();
+	CompressedTrackSample *samples_ptr = r_samples.ptr();
+	CompressedTrackCursor *cursors_ptr = r_cursors.ptr();
+	for (uint32_t i = 0; i < tracks.size(); i++) {
+		CompressedTrackSample &sample = samples_ptr[i];
+		if (p_track_mask && !p_track_mask[i]) {
+			sample.valid = false;
+			continue;
+		}
+		switch (tracks_ptr[i]->type) {
+			case TYPE_POSITION_3D: {
+				const PositionTrack *tt = static_cast<const PositionTrack *>(tracks_ptr[i]);
+				sample.valid = tt->compressed_track >= 0 && _pos_scale_interpolate_compressed(tt->compressed_track, p_time, sample.value, &cursors_ptr[i]);
+			} break;
+			case TYPE_ROTATION_3D: {
+				const RotationTrack *rt = static_cast<const RotationTrack *>(tracks_ptr[i]);
+				sample.valid = rt->compressed_track >= 0 && _rotation_interpolate_compressed(rt->compressed_track, p_time, sample.rotation, &cursors_ptr[i]);
+			} break;
+			case TYPE_SCALE_3D: {
+				const ScaleTrack *st = static_cast<const ScaleTrack *>(tracks_ptr[i]);
+				sample.valid = st->compressed_track >= 0 && _pos_scale_interpolate_compressed(st->compressed_track, p_time, sample.value, &cursors_ptr[i]);
+			} break;
+			case TYPE_BLEND_SHAPE: {
+				const BlendShapeTrack *bst = static_cast<const BlendShapeTrack *>(tracks_ptr[i]);
+				float blend = 0.0;
+				sample.valid = bst->compressed_track >= 0 && _blend_shape_interpolate_compressed(bst->compressed_track, p_time, blend, &cursors_ptr[i]);
+				sample.value.x = blend;
+			} break;
+			default: {
+				sample.valid = false;
+			} break;
+		}
+	}
+
+	return true;
+}
+
 Error Animation::try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
@@ -5265,13 +5310,13 @@ void Animation::compress(uint32_t p_page_size, uint32_t p_fps, float p_split_tol
 #endif
 }
 
-bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret) const {
+bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret, CompressedTrackCursor *r_cursor) const {
 	Vector3i current;
 	Vector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, r_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -5289,13 +5334,13 @@ bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, do
 	return true;
 }
 
-bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret) const {
+bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret, CompressedTrackCursor *r_cursor) const {
 	Vector3i current;
 	Vector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, r_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -5312,13 +5357,13 @@ bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, d
 
 	return true;
 }
-bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret) const {
+bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret, CompressedTrackCursor *r_cursor) const {
 	Vector3i current;
 	Vector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<1>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<1>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, r_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -5336,8 +5381,31 @@ bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track,
 	return true;
 }
 
+int32_t Animation::_find_compressed_page(double p_time, const CompressedTrackCursor *p_cursor) const {
+	const uint32_t page_count = compression.pages.size();
+
+	// Last page starting at or before the time.
+	if (p_cursor && p_cursor->page >= 0 && (uint32_t)p_cursor->page < page_count && compression.pages[p_cursor->page].time_offset <= p_time) {
+		if ((uint32_t)p_cursor->page + 1 == page_count || compression.pages[p_cursor->page + 1].time_offset > p_time) {
+			return p_cursor->page;
+		}
+	}
+
+	uint32_t low = 0;
+	uint32_t high = page_count;
+	while (low < high) {
+		uint32_t middle = (low + high) / 2;
+		if (compression.pages[middle].time_offset > p_time) {
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
+	}
+	return int32_t(low) - 1;
+}
+
 template <uint32_t COMPONENTS>
-bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
+bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index, CompressedTrackCursor *r_cursor) const {
 	ERR_FAIL_COND_V(!compression.enabled, false);
 	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.bounds.size(), false);
 	p_time = CLAMP(p_time, 0, length);
@@ -5347,13 +5415,7 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 
 	double frame_to_sec = 1.0 / double(compression.fps);
 
-	int32_t page_index = -1;
-	for (uint32_t i = 0; i < compression.pages.size(); i++) {
-		if (compression.pages[i].time_offset > p_time) {
-			break;
-		}
-		page_index = i;
-	}
+	int32_t page_index = _find_compressed_page(p_time, r_cursor);
 
 	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
 
@@ -5368,21 +5430,49 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 	double packet_time = double(time_keys[0]) * frame_to_sec + page_base_time;
 	uint32_t base_frame = time_keys[0];
 
-	for (uint32_t i = 1; i < time_key_count; i++) {
-		uint32_t f = time_keys[i * 2 + 0];
-		double frame_time = double(f) * frame_to_sec + page_base_time;
+	if (key_index) {
+		// Counting keys needs to walk all previous time keys anyway.
+		for (uint32_t i = 1; i < time_key_count; i++) {
+			uint32_t f = time_keys[i * 2 + 0];
+			double frame_time = double(f) * frame_to_sec + page_base_time;
 
-		if (frame_time > p_time) {
-			break;
-		}
+			if (frame_time > p_time) {
+				break;
+			}
 
-		if (key_index) {
 			(*key_index) += (time_keys[(i - 1) * 2 + 1] >> 12) + 1;
+
+			packet_idx = i;
+			packet_time = frame_time;
+			base_frame = f;
+		}
+	} else {
+		// Last time key at or before the time, resuming from the cursor when playing forward, which usually finds it within one step.
+		uint32_t low = 1;
+		uint32_t high = time_key_count;
+		if (r_cursor && r_cursor->page == page_index && r_cursor->time_key < time_key_count && double(time_keys[r_cursor->time_key * 2 + 0]) * frame_to_sec + page_base_time <= p_time) {
+			low = r_cursor->time_key + 1;
+			if (low < high && double(time_keys[low * 2 + 0]) * frame_to_sec + page_base_time > p_time) {
+				high = low;
+			}
+		}
+		while (low < high) {
+			uint32_t middle = (low + high) / 2;
+			if (double(time_keys[middle * 2 + 0]) * frame_to_sec + page_base_time > p_time) {
+				high = middle;
+			} else {
+				low = middle + 1;
+			}
 		}
 
-		packet_idx = i;
-		packet_time = frame_time;
-		base_frame = f;
+		packet_idx = low - 1;
+		base_frame = time_keys[packet_idx * 2 + 0];
+		packet_time = double(base_frame) * frame_to_sec + page_base_time;
+	}
+
+	if (r_cursor) {
+		r_cursor->page = page_index;
+		r_cursor->time_key = packet_idx;
 	}
 
 	const uint8_t *data_keys_base = (const uint8_t *)&page_data[indices[p_compressed_track * 3 + 2]];
@@ -355,12 +355,27 @@ private:
 		bool enabled = false;
 	} compression;
 
+public:
+	// Where the last sample of a compressed track was found, so the next one resumes from there instead of searching the page.
+	struct CompressedTrackCursor {
+		int32_t page = -1;
+		uint32_t time_key = 0;
+	};
+
+	struct CompressedTrackSample {
+		Quaternion rotation; // Rotation tracks.
+		Vector3 value; // Position and scale tracks, or blend shape tracks in x.
+		bool valid = false;
+	};
+
+private:
 	Vector3i _compress_key(uint32_t p_track, const AABB &p_bounds, int32_t p_key = -1, float p_time = 0.0);
-	bool _rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret) const;
-	bool _pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret) const;
-	bool _blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret) const;
+	bool _rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret, CompressedTrackCursor *r_cursor = nullptr) const;
+	bool _pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret, CompressedTrackCursor *r_cursor = nullptr) const;
+	bool _blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret, CompressedTrackCursor *r_cursor = nullptr) const;
+	int32_t _find_compressed_page(double p_time, const CompressedTrackCursor *p_cursor = nullptr) const;
 	template <uint32_t COMPONENTS>
-	bool _fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr) const;
+	bool _fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr, CompressedTrackCursor *r_cursor = nullptr) const;
 	template <uint32_t COMPONENTS>
 	bool _fetch_compressed_by_index(uint32_t p_compressed_track, int p_index, Vector3i &r_value, double &r_time) const;
 	int _get_compressed_key_count(uint32_t p_compressed_track) const;
@@ -467,6 +482,12 @@ public:
 	Error try_blend_shape_track_interpolate(int p_track, double p_time, float *r_blend, bool p_backward = false) const;
 	float blend_shape_track_interpolate(int p_track, double p_time, bool p_backward = false) const;
 
+	_FORCE_INLINE_ bool is_compressed() const { return compression.enabled; }
+
+	// Samples all compressed tracks at once, resuming from the cursors of the previous call. Returns false if the animation isn't compressed.
+	// If a track mask is given (one entry per track), the tracks left out of it are not decoded and their samples are invalid.
+	bool sample_compressed_tracks(double p_time, LocalVector<CompressedTrackSample> &r_samples, LocalVector<CompressedTrackCursor> &r_cursors, const bool *p_track_mask = nullptr) const;
+
 	void track_set_interpolation_type(int p_track, InterpolationType p_interp);
 	InterpolationType track_get_interpolation_type(int p_track) const;
 
@@ -0,0 +1,702 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RASTER_OCCLUSION_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define RASTER_OCCLUSION_NEON
+#include <arm_neon.h>
+#endif
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	instance_rasters.clear();
+	tile_bin_ends.clear();
+	tile_bin_triangles.clear();
+	column_ray_factors.clear();
+	row_ray_factors.clear();
+	tile_grid_size = Size2i();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	tile_grid_size = Size2i((p_size.x + TILE_SIZE - 1) / TILE_SIZE, (p_size.y + TILE_SIZE - 1) / TILE_SIZE);
+	column_ray_factors.resize(p_size.x);
+	row_ray_factors.resize(p_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_emit_triangle(LocalVector<Triangle> &r_triangles, const Vector4 *p_clip, const float *p_depth, const Vector2 &p_jitter) const {
+	const Size2i &buffer_size = sizes[0];
+
+	float x[3];
+	float y[3];
+	float inv_w[3];
+	float depth_w[3];
+	for (int i = 0; i < 3; i++) {
+		if (p_clip[i].w <= 0.0f) {
+			return;
+		}
+		inv_w[i] = 1.0f / p_clip[i].w;
+		x[i] = (p_clip[i].x * inv_w[i] * 0.5f + 0.5f) * buffer_size.x - p_jitter.x;
+		y[i] = (p_clip[i].y * inv_w[i] * 0.5f + 0.5f) * buffer_size.y - p_jitter.y;
+		depth_w[i] = p_depth[i] * inv_w[i];
+	}
+
+	// Pixels are sampled at their centers, only those inside the bounds can be covered.
+	// Clamp before converting to avoid overflowing with vertices close to the camera plane.
+	int min_x = MAX(0, (int)Math::ceil(CLAMP(MIN(x[0], MIN(x[1], x[2])) - 0.5f, -1.0f, (float)buffer_size.x)));
+	int min_y = MAX(0, (int)Math::ceil(CLAMP(MIN(y[0], MIN(y[1], y[2])) - 0.5f, -1.0f, (float)buffer_size.y)));
+	int max_x = MIN(buffer_size.x - 1, (int)Math::floor(CLAMP(MAX(x[0], MAX(x[1], x[2])) - 0.5f, -1.0f, (float)buffer_size.x)));
+	int max_y = MIN(buffer_size.y - 1, (int)Math::floor(CLAMP(MAX(y[0], MAX(y[1], y[2])) - 0.5f, -1.0f, (float)buffer_size.y)));
+
+	if (min_x > max_x || min_y > max_y) {
+		return;
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (Math::abs(area) < (float)CMP_EPSILON) {
+		return;
+	}
+	float inv_area = 1.0f / area;
+
+	Triangle triangle;
+
+	// Edge functions of the edges opposite to each vertex, divided by the signed area
+	// so they become barycentric coordinates regardless of the triangle winding.
+	for (int i = 0; i < 3; i++) {
+		int a = (i + 1) % 3;
+		int b = (i + 2) % 3;
+		float dx = -(y[b] - y[a]) * inv_area;
+		float dy = (x[b] - x[a]) * inv_area;
+		triangle.barycentrics[i][0] = dx;
+		triangle.barycentrics[i][1] = dy;
+		triangle.barycentrics[i][2] = -(dx * x[a] + dy * y[a]);
+	}
+
+	// 1/w and depth/w are linear in screen space, so they can be interpolated with the barycentrics.
+	for (int k = 0; k < 3; k++) {
+		triangle.inv_w[k] = 0.0f;
+		triangle.depth_w[k] = 0.0f;
+		for (int i = 0; i < 3; i++) {
+			triangle.inv_w[k] += triangle.barycentrics[i][k] * inv_w[i];
+			triangle.depth_w[k] += triangle.barycentrics[i][k] * depth_w[i];
+		}
+	}
+
+	triangle.min_x = min_x;
+	triangle.min_y = min_y;
+	triangle.max_x = max_x;
+	triangle.max_y = max_y;
+
+	r_triangles.push_back(triangle);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_instance_triangles(uint32_t p_index, const RasterThreadData *p_data) {
+	const OccluderInstance *occ_inst = p_data->instances[p_index];
+	InstanceRaster &raster = instance_rasters[p_index];
+	raster.triangles.clear();
+	raster.tile_entries.clear();
+
+	uint32_t vertex_count = occ_inst->xformed_vertices.size();
+	raster.clip_vertices.resize(vertex_count);
+	raster.depths.resize(vertex_count);
+
+	const Vector3 *vertices = occ_inst->xformed_vertices.ptr();
+	Vector4 *clip = raster.clip_vertices.ptr();
+	float *depths = raster.depths.ptr();
+
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		const Vector3 &v = vertices[i];
+		clip[i] = p_data->world_to_clip.xform(Vector4(v.x, v.y, v.z, 1.0));
+		depths[i] = p_data->view_depth_plane.distance_to(v);
+	}
+
+	const uint32_t *indices = occ_inst->indices.ptr();
+	uint32_t index_count = occ_inst->indices.size() - occ_inst->indices.size() % 3;
+
+	for (uint32_t i = 0; i < index_count; i += 3) {
+		uint32_t i0 = indices[i + 0];
+		uint32_t i1 = indices[i + 1];
+		uint32_t i2 = indices[i + 2];
+
+		if (i0 >= vertex_count || i1 >= vertex_count || i2 >= vertex_count) {
+			continue;
+		}
+
+		Vector4 tri_clip[3] = { clip[i0], clip[i1], clip[i2] };
+		float tri_depth[3] = { depths[i0], depths[i1], depths[i2] };
+
+		// Reject triangles entirely outside one of the side planes.
+		if ((tri_clip[0].x < -tri_clip[0].w && tri_clip[1].x < -tri_clip[1].w && tri_clip[2].x < -tri_clip[2].w) ||
+				(tri_clip[0].x > tri_clip[0].w && tri_clip[1].x > tri_clip[1].w && tri_clip[2].x > tri_clip[2].w) ||
+				(tri_clip[0].y < -tri_clip[0].w && tri_clip[1].y < -tri_clip[1].w && tri_clip[2].y < -tri_clip[2].w) ||
+				(tri_clip[0].y > tri_clip[0].w && tri_clip[1].y > tri_clip[1].w && tri_clip[2].y > tri_clip[2].w)) {
+			continue;
+		}
+
+		// Clip against the near plane (z >= -w), which turns the triangle into a triangle or a quad.
+		float near_dist[3];
+		int inside_count = 0;
+		for (int j = 0; j < 3; j++) {
+			near_dist[j] = tri_clip[j].z + tri_clip[j].w;
+			inside_count += near_dist[j] >= 0.0f ? 1 : 0;
+		}
+
+		if (inside_count == 0) {
+			continue;
+		}
+
+		if (inside_count == 3) {
+			_emit_triangle(raster.triangles, tri_clip, tri_depth, p_data->jitter);
+			continue;
+		}
+
+		Vector4 poly_clip[4];
+		float poly_depth[4];
+		int poly_count = 0;
+
+		for (int j = 0; j < 3; j++) {
+			int k = (j + 1) % 3;
+			if (near_dist[j] >= 0.0f) {
+				poly_clip[poly_count] = tri_clip[j];
+				poly_depth[poly_count] = tri_depth[j];
+				poly_count++;
+			}
+			if ((near_dist[j] >= 0.0f) != (near_dist[k] >= 0.0f)) {
+				float t = near_dist[j] / (near_dist[j] - near_dist[k]);
+				poly_clip[poly_count] = tri_clip[j] + (tri_clip[k] - tri_clip[j]) * t;
+				poly_depth[poly_count] = tri_depth[j] + (tri_depth[k] - tri_depth[j]) * t;
+				poly_count++;
+			}
+		}
+
+		_emit_triangle(raster.triangles, poly_clip, poly_depth, p_data->jitter);
+		if (poly_count == 4) {
+			Vector4 second_clip[3] = { poly_clip[0], poly_clip[2], poly_clip[3] };
+			float second_depth[3] = { poly_depth[0], poly_depth[2], poly_depth[3] };
+			_emit_triangle(raster.triangles, second_clip, second_depth, p_data->jitter);
+		}
+	}
+
+	// Record the tiles overlapped by each triangle's screen-space bounds, so tiles only walk the triangles that can cover them.
+	for (uint32_t i = 0; i < raster.triangles.size(); i++) {
+		const Triangle &t = raster.triangles[i];
+		for (int tile_y = t.min_y / TILE_SIZE; tile_y <= t.max_y / TILE_SIZE; tile_y++) {
+			for (int tile_x = t.min_x / TILE_SIZE; tile_x <= t.max_x / TILE_SIZE; tile_x++) {
+				raster.tile_entries.push_back({ uint32_t(tile_y * tile_grid_size.x + tile_x), i });
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_bin_triangles(uint32_t p_instance_count) {
+	uint32_t tile_count = tile_grid_size.x * tile_grid_size.y;
+	tile_bin_ends.resize(tile_count);
+	memset(tile_bin_ends.ptr(), 0, tile_count * sizeof(uint32_t));
+
+	uint32_t entry_count = 0;
+	for (uint32_t i = 0; i < p_instance_count; i++) {
+		for (const TileBinEntry &e : instance_rasters[i].tile_entries) {
+			tile_bin_ends[e.tile]++;
+		}
+		entry_count += instance_rasters[i].tile_entries.size();
+	}
+
+	// Turn the counts into bin starts. Filling the bins then advances each start to the end of its bin.
+	uint32_t start = 0;
+	for (uint32_t i = 0; i < tile_count; i++) {
+		uint32_t count = tile_bin_ends[i];
+		tile_bin_ends[i] = start;
+		start += count;
+	}
+
+	tile_bin_triangles.resize(entry_count);
+	for (uint32_t i = 0; i < p_instance_count; i++) {
+		const InstanceRaster &raster = instance_rasters[i];
+		for (const TileBinEntry &e : raster.tile_entries) {
+			tile_bin_triangles[tile_bin_ends[e.tile]++] = &raster.triangles[e.triangle];
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_tile(uint32_t p_tile, const RasterThreadData *p_data) {
+	const Size2i &buffer_size = sizes[0];
+
+	int tile_min_x = (p_tile % tile_grid_size.x) * TILE_SIZE;
+	int tile_min_y = (p_tile / tile_grid_size.x) * TILE_SIZE;
+	int tile_max_x = MIN(tile_min_x + TILE_SIZE, buffer_size.x) - 1;
+	int tile_max_y = MIN(tile_min_y + TILE_SIZE, buffer_size.y) - 1;
+
+	float *depth = mips[0];
+	const float *column_factors = column_ray_factors.ptr();
+
+	for (int y = tile_min_y; y <= tile_max_y; y++) {
+		float *row = depth + y * buffer_size.x;
+		for (int x = tile_min_x; x <= tile_max_x; x++) {
+			row[x] = FLT_MAX;
+		}
+	}
+
+	// Each tile only writes its own pixels, so tiles can be rasterized in parallel without synchronization.
+	const uint32_t bin_begin = p_tile > 0 ? tile_bin_ends[p_tile - 1] : 0;
+	const uint32_t bin_end = tile_bin_ends[p_tile];
+	for (uint32_t i = bin_begin; i < bin_end; i++) {
+		const Triangle &t = *tile_bin_triangles[i];
+		int min_x = MAX(t.min_x, tile_min_x);
+		int min_y = MAX(t.min_y, tile_min_y);
+		int max_x = MIN(t.max_x, tile_max_x);
+		int max_y = MIN(t.max_y, tile_max_y);
+
+		if (min_x > max_x || min_y > max_y) {
+			continue;
+		}
+
+		for (int y = min_y; y <= max_y; y++) {
+			const float py = y + 0.5f;
+			const float b0 = t.barycentrics[0][1] * py + t.barycentrics[0][2];
+			const float b1 = t.barycentrics[1][1] * py + t.barycentrics[1][2];
+			const float b2 = t.barycentrics[2][1] * py + t.barycentrics[2][2];
+			const float iw = t.inv_w[1] * py + t.inv_w[2];
+			const float dw = t.depth_w[1] * py + t.depth_w[2];
+			const float row_factor = row_ray_factors[y];
+			float *row = depth + y * buffer_size.x;
+
+			int x = min_x;
+
+			// Four pixels at a time. Pixels outside the triangle may produce
+			// infinities or NaNs in the depth, they are discarded by the mask.
+#if defined(RASTER_OCCLUSION_SSE2)
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 lane_offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+			const __m128 b0_dx = _mm_set1_ps(t.barycentrics[0][0]);
+			const __m128 b1_dx = _mm_set1_ps(t.barycentrics[1][0]);
+			const __m128 b2_dx = _mm_set1_ps(t.barycentrics[2][0]);
+			const __m128 iw_dx = _mm_set1_ps(t.inv_w[0]);
+			const __m128 dw_dx = _mm_set1_ps(t.depth_w[0]);
+
+			for (; x + 3 <= max_x; x += 4) {
+				__m128 px = _mm_add_ps(_mm_set1_ps((float)x), lane_offsets);
+				__m128 l0 = _mm_add_ps(_mm_mul_ps(b0_dx, px), _mm_set1_ps(b0));
+				__m128 l1 = _mm_add_ps(_mm_mul_ps(b1_dx, px), _mm_set1_ps(b1));
+				__m128 l2 = _mm_add_ps(_mm_mul_ps(b2_dx, px), _mm_set1_ps(b2));
+				__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(l0, zero), _mm_cmpge_ps(l1, zero)), _mm_cmpge_ps(l2, zero));
+
+				__m128 w = _mm_add_ps(_mm_mul_ps(iw_dx, px), _mm_set1_ps(iw));
+				__m128 d = _mm_div_ps(_mm_add_ps(_mm_mul_ps(dw_dx, px), _mm_set1_ps(dw)), w);
+				d = _mm_mul_ps(d, _mm_sqrt_ps(_mm_add_ps(_mm_set1_ps(row_factor), _mm_loadu_ps(column_factors + x))));
+
+				__m128 prev = _mm_loadu_ps(row + x);
+				__m128 mask = _mm_and_ps(inside, _mm_cmplt_ps(d, prev));
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(mask, d), _mm_andnot_ps(mask, prev)));
+			}
+#elif defined(RASTER_OCCLUSION_NEON)
+			const float32x4_t zero = vdupq_n_f32(0.0f);
+			const float lane_offsets_array[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+			const float32x4_t lane_offsets = vld1q_f32(lane_offsets_array);
+			const float32x4_t b0_dx = vdupq_n_f32(t.barycentrics[0][0]);
+			const float32x4_t b1_dx = vdupq_n_f32(t.barycentrics[1][0]);
+			const float32x4_t b2_dx = vdupq_n_f32(t.barycentrics[2][0]);
+			const float32x4_t iw_dx = vdupq_n_f32(t.inv_w[0]);
+			const float32x4_t dw_dx = vdupq_n_f32(t.depth_w[0]);
+
+			for (; x + 3 <= max_x; x += 4) {
+				float32x4_t px = vaddq_f32(vdupq_n_f32((float)x), lane_offsets);
+				float32x4_t l0 = vmlaq_f32(vdupq_n_f32(b0), b0_dx, px);
+				float32x4_t l1 = vmlaq_f32(vdupq_n_f32(b1), b1_dx, px);
+				float32x4_t l2 = vmlaq_f32(vdupq_n_f32(b2), b2_dx, px);
+				uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(l0, zero), vcgeq_f32(l1, zero)), vcgeq_f32(l2, zero));
+
+				float32x4_t w = vmlaq_f32(vdupq_n_f32(iw), iw_dx, px);
+				float32x4_t d = vdivq_f32(vmlaq_f32(vdupq_n_f32(dw), dw_dx, px), w);
+				d = vmulq_f32(d, vsqrtq_f32(vaddq_f32(vdupq_n_f32(row_factor), vld1q_f32(column_factors + x))));
+
+				float32x4_t prev = vld1q_f32(row + x);
+				uint32x4_t mask = vandq_u32(inside, vcltq_f32(d, prev));
+				vst1q_f32(row + x, vbslq_f32(mask, d, prev));
+			}
+#endif
+
+			for (; x <= max_x; x++) {
+				const float px = x + 0.5f;
+				const float l0 = t.barycentrics[0][0] * px + b0;
+				const float l1 = t.barycentrics[1][0] * px + b1;
+				const float l2 = t.barycentrics[2][0] * px + b2;
+				if (l0 < 0.0f || l1 < 0.0f || l2 < 0.0f) {
+					continue;
+				}
+
+				float d = (t.depth_w[0] * px + dw) / (t.inv_w[0] * px + iw) * Math::sqrt(row_factor + column_factors[x]);
+				if (d < row[x]) {
+					row[x] = d;
+				}
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const LocalVector<const OccluderInstance *> &p_instances, const Transform3D &p_cam_transform, const Projection &p_world_to_clip, const Rect2 &p_viewport_rect, const Vector2 &p_jitter, real_t p_z_near, real_t p_z_far, bool p_cam_orthogonal) {
+	const Size2i &buffer_size = sizes[0];
+
+	RasterThreadData td;
+	td.instances = p_instances.ptr();
+	td.instance_count = p_instances.size();
+	td.world_to_clip = p_world_to_clip;
+	td.view_depth_plane = Plane(-p_cam_transform.basis.get_column(2).normalized(), p_cam_transform.origin);
+	td.jitter = p_jitter / p_viewport_rect.size * Vector2(buffer_size);
+
+	// The occlusion buffer stores distances along the pixel rays (like RaycastOcclusionCull does), which
+	// matches the depth along the view axis for orthogonal cameras. For perspective cameras, the distance
+	// is the view depth scaled by the length of the ray through the pixel center on the unit depth plane.
+	Vector2 pixel_size = p_viewport_rect.size / Vector2(buffer_size);
+	Vector2 first_pixel = p_viewport_rect.position + p_jitter + pixel_size * 0.5;
+	for (int x = 0; x < buffer_size.x; x++) {
+		float slope = (first_pixel.x + pixel_size.x * x) / p_z_near;
+		column_ray_factors[x] = p_cam_orthogonal ? 0.0f : slope * slope;
+	}
+	for (int y = 0; y < buffer_size.y; y++) {
+		float slope = (first_pixel.y + pixel_size.y * y) / p_z_near;
+		row_ray_factors[y] = 1.0f + (p_cam_orthogonal ? 0.0f : slope * slope);
+	}
+
+	debug_tex_range = p_z_far;
+
+	if (instance_rasters.size() < td.instance_count) {
+		instance_rasters.resize(td.instance_count);
+	}
+
+	if (td.instance_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_setup_instance_triangles, (const RasterThreadData *)&td, td.instance_count, -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (td.instance_count == 1) {
+		_setup_instance_triangles(0, &td);
+	}
+
+	_bin_triangles(td.instance_count);
+
+	uint32_t tile_count = tile_grid_size.x * tile_grid_size.y;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_tile, (const RasterThreadData *)&td, tile_count, -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		RID scenario_rid = E.scenario;
+		RID instance_rid = E.instance;
+		ERR_CONTINUE(!scenarios.has(scenario_rid));
+		Scenario &scenario = scenarios[scenario_rid];
+		ERR_CONTINUE(!scenario.instances.has(instance_rid));
+
+		if (!scenario.dirty_instances.has(instance_rid)) {
+			scenario.dirty_instances.insert(instance_rid);
+			scenario.dirty_instances_array.push_back(instance_rid);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario.removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	// Disabled instances are skipped when rasterizing, they don't need to be transformed again.
+	instance.enabled = p_enabled;
+
+	if (changed && !scenario.dirty_instances.has(p_instance)) {
+		scenario.dirty_instances.insert(p_instance);
+		scenario.dirty_instances_array.push_back(p_instance);
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		if (!instance.removed) {
+			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+			if (occluder) {
+				occluder->users.erase(InstanceID(p_scenario, p_instance));
+			}
+
+			scenario.removed_instances.push_back(p_instance);
+			instance.removed = true;
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(uint32_t p_idx, const RID *p_instances) {
+	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	Occluder *occ = raster_singleton->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ || occ->vertices.is_empty()) {
+		occ_inst->xformed_vertices.clear();
+		occ_inst->indices.clear();
+		occ_inst->aabb = AABB();
+		return;
+	}
+
+	int vertices_size = occ->vertices.size();
+	occ_inst->xformed_vertices.resize(vertices_size);
+
+	const Vector3 *read_ptr = occ->vertices.ptr();
+	Vector3 *write_ptr = occ_inst->xformed_vertices.ptr();
+
+	write_ptr[0] = occ_inst->xform.xform(read_ptr[0]);
+	occ_inst->aabb = AABB(write_ptr[0], Vector3());
+	for (int i = 1; i < vertices_size; i++) {
+		write_ptr[i] = occ_inst->xform.xform(read_ptr[i]);
+		occ_inst->aabb.expand_to(write_ptr[i]);
+	}
+
+	occ_inst->indices.resize(occ->indices.size());
+	memcpy(occ_inst->indices.ptr(), occ->indices.ptr(), occ->indices.size() * sizeof(int32_t));
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	if (removed_instances.is_empty() && dirty_instances_array.is_empty()) {
+		return;
+	}
+
+	for (const RID &instance : removed_instances) {
+		instances.erase(instance);
+	}
+
+	if (dirty_instances_array.size() / WorkerThreadPool::get_singleton()->get_thread_count() > 128) {
+		// Lots of instances, use per-instance threading
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance, (const RID *)dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RasterOcclusionCullUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < dirty_instances_array.size(); i++) {
+			_update_dirty_instance(i, dirty_instances_array.ptr());
+		}
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+static bool _is_aabb_outside_frustum(const AABB &p_aabb, const Projection &p_world_to_clip) {
+	uint32_t outside = 0x3F;
+
+	for (int i = 0; i < 8; i++) {
+		Vector3 p = p_aabb.get_endpoint(i);
+		Vector4 c = p_world_to_clip.xform(Vector4(p.x, p.y, p.z, 1.0));
+
+		uint32_t code = 0;
+		code |= c.x < -c.w ? 1 : 0;
+		code |= c.x > c.w ? 2 : 0;
+		code |= c.y < -c.w ? 4 : 0;
+		code |= c.y > c.w ? 8 : 0;
+		code |= c.z < -c.w ? 16 : 0;
+		code |= c.z > c.w ? 32 : 0;
+		outside &= code;
+	}
+
+	// All corners are on the outer side of the same plane.
+	return outside != 0;
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+	scenario.update();
+
+	Projection world_to_clip = p_cam_projection * Projection(p_cam_transform.affine_inverse());
+
+	visible_instances.clear();
+	for (const KeyValue<RID, OccluderInstance> &E : scenario.instances) {
+		const OccluderInstance &occ_inst = E.value;
+		if (!occ_inst.enabled || occ_inst.indices.is_empty() || _is_aabb_outside_frustum(occ_inst.aabb, world_to_clip)) {
+			continue;
+		}
+		visible_instances.push_back(&occ_inst);
+	}
+
+	Rect2 vp_rect = _get_viewport_rect(p_cam_projection);
+	Vector2 jitter = _get_jitter(vp_rect, buffer.get_occlusion_buffer_size());
+
+	buffer.rasterize(visible_instances, p_cam_transform, world_to_clip, vp_rect, jitter, p_cam_projection.get_z_near(), p_cam_projection.get_z_far(), p_cam_orthogonal);
+	buffer.update_mips();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	raster_singleton = nullptr;
+}
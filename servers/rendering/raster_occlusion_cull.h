@@ -0,0 +1,181 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "core/math/projection.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Occlusion culling backend that renders occluder meshes into the occlusion
+// buffer with a tiled software depth rasterizer. Unlike RaycastOcclusionCull,
+// it has no external dependency and runs on any CPU architecture.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<Vector3> xformed_vertices;
+		LocalVector<uint32_t> indices;
+		AABB aabb;
+		Transform3D xform;
+		bool enabled = true;
+		bool removed = false;
+	};
+
+public:
+	class RasterHZBuffer : public HZBuffer {
+	public:
+		static const int TILE_SIZE = 16;
+
+		// Screen-space triangle, set up so every attribute is a plane
+		// `a * x + b * y + c` evaluated at pixel centers.
+		struct Triangle {
+			float barycentrics[3][3]; // Normalized edge functions, all >= 0 inside the triangle.
+			float inv_w[3];
+			float depth_w[3]; // Linear view depth divided by w.
+			int min_x = 0;
+			int min_y = 0;
+			int max_x = 0;
+			int max_y = 0;
+		};
+
+	private:
+		struct RasterThreadData {
+			const OccluderInstance *const *instances = nullptr;
+			uint32_t instance_count = 0;
+			Projection world_to_clip;
+			Plane view_depth_plane;
+			Vector2 jitter; // In pixels.
+		};
+
+		struct TileBinEntry {
+			uint32_t tile = 0;
+			uint32_t triangle = 0;
+		};
+
+		// Per visible occluder instance scratch, kept between frames to avoid reallocations.
+		struct InstanceRaster {
+			LocalVector<Vector4> clip_vertices;
+			LocalVector<float> depths;
+			LocalVector<Triangle> triangles;
+			LocalVector<TileBinEntry> tile_entries; // One entry per tile overlapped by each triangle's bounds.
+		};
+
+		Size2i tile_grid_size;
+		LocalVector<InstanceRaster> instance_rasters;
+
+		// Triangles overlapping each tile. Once binned, the triangles of tile `t` are
+		// `tile_bin_triangles[t > 0 ? tile_bin_ends[t - 1] : 0]` up to `tile_bin_triangles[tile_bin_ends[t]]`.
+		LocalVector<uint32_t> tile_bin_ends;
+		LocalVector<const Triangle *> tile_bin_triangles;
+
+		// Squared ray slopes per column and row, turning linear view depth into distance along the pixel ray.
+		LocalVector<float> column_ray_factors;
+		LocalVector<float> row_ray_factors;
+
+		void _emit_triangle(LocalVector<Triangle> &r_triangles, const Vector4 *p_clip, const float *p_depth, const Vector2 &p_jitter) const;
+		void _setup_instance_triangles(uint32_t p_index, const RasterThreadData *p_data);
+		void _bin_triangles(uint32_t p_instance_count);
+		void _rasterize_tile(uint32_t p_tile, const RasterThreadData *p_data);
+
+	public:
+		RID scenario_rid;
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+		void rasterize(const LocalVector<const OccluderInstance *> &p_instances, const Transform3D &p_cam_transform, const Projection &p_world_to_clip, const Rect2 &p_viewport_rect, const Vector2 &p_jitter, real_t p_z_near, real_t p_z_far, bool p_cam_orthogonal);
+	};
+
+private:
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+		HashSet<RID> dirty_instances; // To avoid duplicates
+		LocalVector<RID> dirty_instances_array; // To iterate and split into threads
+		LocalVector<RID> removed_instances;
+
+		void _update_dirty_instance(uint32_t p_idx, const RID *p_instances);
+		void update();
+	};
+
+	static RasterOcclusionCull *raster_singleton;
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+	LocalVector<const OccluderInstance *> visible_instances;
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RasterOcclusionCull();
+	~RasterOcclusionCull();
+};
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
 
@@ -486,6 +487,7 @@ RID RendererSceneCull::scenario_get_environment(RID p_scenario) {
 void RendererSceneCull::scenario_remove_viewport_visibility_mask(RID p_scenario, RID p_viewport) {
 	Scenario *scenario = scenario_owner.get_or_null(p_scenario);
 	ERR_FAIL_NULL(scenario);
+	scenario->frustum_cull_caches.erase(p_viewport);
 	if (!scenario->viewport_visibility_masks.has(p_viewport)) {
 		return;
 	}
@@ -996,6 +998,38 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	_instance_queue_update(instance, true);
 }
 
+void RendererSceneCull::instances_set_transforms(const PackedInt64Array &p_instances, const PackedFloat32Array &p_transforms) {
+	const int count = p_instances.size();
+	ERR_FAIL_COND_MSG(p_transforms.size() != count * 12, vformat("Transform buffer size must be 12 floats per instance (expected %d, got %d).", count * 12, p_transforms.size()));
+
+	const int64_t *instances = p_instances.ptr();
+	const float *r = p_transforms.ptr();
+
+	for (int i = 0; i < count; i++) {
+		const float *data = &r[i * 12];
+		Transform3D xform;
+		xform.basis.rows[0] = Vector3(data[0], data[1], data[2]);
+		xform.basis.rows[1] = Vector3(data[4], data[5], data[6]);
+		xform.basis.rows[2] = Vector3(data[8], data[9], data[10]);
+		xform.origin = Vector3(data[3], data[7], data[11]);
+
+		Instance *instance = instance_owner.get_or_null(RID::from_uint64(instances[i]));
+		ERR_CONTINUE(!instance);
+
+		if (instance->transform == xform) {
+			continue;
+		}
+
+#ifdef DEBUG_ENABLED
+		ERR_CONTINUE(!xform.is_finite());
+#endif
+
+		instance->transform = xform;
+		instance->batched_transform = true;
+		_instance_queue_update(instance, true);
+	}
+}
+
 void RendererSceneCull::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL(instance);
@@ -1764,6 +1798,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		idata.parent_array_index = p_instance->visibility_parent ? p_instance->visibility_parent->array_index : -1;
 		idata.visibility_index = p_instance->visibility_index;
 		idata.occlusion_timeout = 0;
+		idata.bounds_version = ++p_instance->scenario->bounds_version;
 
 		for (Instance *E : p_instance->visibility_dependencies) {
 			Instance *dep_instance = E;
@@ -1839,12 +1874,17 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
-		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
+		if (((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) && p_instance->batched_transform) {
+			p_instance->scenario->indexer_refit_ids.push_back(p_instance->indexer_id);
+			p_instance->scenario->indexer_refit_aabbs.push_back(bvh_aabb);
+			indexer_refits_pending = true;
+		} else if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb);
 		} else {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_data[p_instance->array_index].bounds_version = ++p_instance->scenario->bounds_version;
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1900,6 +1940,11 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		pair.bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
 	}
 
+	if (pair.bvh) {
+		// Geometry is about to be queried, make sure batched moves are reflected in it.
+		_scenario_flush_indexer_refits(p_instance->scenario);
+	}
+
 	pair.pair();
 
 	p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
@@ -1918,6 +1963,8 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 	}
 
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
+		// A pending refit may still reference this leaf.
+		_scenario_flush_indexer_refits(p_instance->scenario);
 		p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].remove(p_instance->indexer_id);
 	} else {
 		p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].remove(p_instance->indexer_id);
@@ -1932,6 +1979,8 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		// Cached results are stored per array index, they belonged to the removed instance.
+		p_instance->scenario->instance_data[p_instance->array_index].bounds_version = ++p_instance->scenario->bounds_version;
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -2804,6 +2853,25 @@ bool RendererSceneCull::_visibility_parent_check(const CullData &p_cull_data, co
 	return ((parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE) || (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 }
 
+bool RendererSceneCull::_in_camera_frustum(const CullData &p_cull_data, uint64_t p_index, const InstanceData &p_instance_data, uint32_t &r_tested, uint32_t &r_reused) {
+	Scenario::FrustumCullResult *cached = p_cull_data.frustum_cache_results;
+	if (cached == nullptr) {
+		r_tested++;
+		return p_cull_data.scenario->instance_aabbs[p_index].in_frustum(p_cull_data.cull->frustum);
+	}
+
+	Scenario::FrustumCullResult &result = cached[p_index];
+	if (result.bounds_version != 0 && result.bounds_version == p_instance_data.bounds_version) {
+		r_reused++;
+		return result.inside;
+	}
+
+	r_tested++;
+	result.inside = p_cull_data.scenario->instance_aabbs[p_index].in_frustum(p_cull_data.cull->frustum);
+	result.bounds_version = p_instance_data.bounds_version;
+	return result.inside;
+}
+
 void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_data) {
 	uint32_t cull_total = cull_data->scenario->instance_data.size();
 	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
@@ -2826,6 +2894,9 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	float z_near = cull_data.camera_matrix->get_z_near();
 	bool is_orthogonal = cull_data.camera_matrix->is_orthogonal();
 
+	uint32_t frustum_tested = 0;
+	uint32_t frustum_reused = 0;
+
 	for (uint64_t i = p_from; i < p_to; i++) {
 		bool mesh_visible = false;
 
@@ -2842,7 +2913,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near, is_orthogonal, cull_data.scenario->instance_data[i].occlusion_timeout))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((LAYER_CHECK && _in_camera_frustum(cull_data, i, idata, frustum_tested, frustum_reused) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -3092,6 +3163,9 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 			cull_result.mesh_instances.push_back(cull_data.scenario->instance_data[i].instance->mesh_instance);
 		}
 	}
+
+	instances_frustum_tested.add(frustum_tested);
+	instances_frustum_reused.add(frustum_reused);
 }
 
 void RendererSceneCull::_scene_particles_set_view_axis(RID p_particles, const Vector3 &p_axis, const Vector3 &p_up_axis) {
@@ -3235,6 +3309,27 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
+
+		// Reuse the camera frustum test results of previous frames while the camera doesn't move.
+		// Reflection probes render six different faces, so they are always tested again.
+		Scenario::FrustumCullCache *frustum_cache = nullptr;
+		if (render_reflection_probe == nullptr && p_viewport.is_valid()) {
+			frustum_cache = &scenario->frustum_cull_caches[p_viewport];
+
+			bool frustum_changed = frustum_cache->planes.size() != planes.size();
+			for (int i = 0; i < planes.size() && !frustum_changed; i++) {
+				frustum_changed = !frustum_cache->planes[i].is_equal_approx(planes[i]);
+			}
+
+			if (frustum_changed) {
+				// Keep the planes the results were computed with, so small changes can't accumulate.
+				frustum_cache->planes = planes;
+				frustum_cache->results.clear();
+			}
+			frustum_cache->results.resize(cull_to);
+
+			cull_data.frustum_cache_results = frustum_cache->results.ptr();
+		}
 //#define DEBUG_CULL_TIME
 #ifdef DEBUG_CULL_TIME
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
@@ -4136,20 +4231,46 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) const {
 	_update_instance(p_instance);
 
 	p_instance->teleported = false;
+	p_instance->batched_transform = false;
 	p_instance->update_aabb = false;
 	p_instance->update_dependencies = false;
 }
 
+void RendererSceneCull::_scenario_flush_indexer_refits(Scenario *p_scenario) const {
+	if (p_scenario->indexer_refit_ids.is_empty()) {
+		return;
+	}
+
+	p_scenario->indexers[Scenario::INDEXER_GEOMETRY].refit(p_scenario->indexer_refit_ids.ptr(), p_scenario->indexer_refit_aabbs.ptr(), p_scenario->indexer_refit_ids.size());
+	p_scenario->indexer_refit_ids.clear();
+	p_scenario->indexer_refit_aabbs.clear();
+}
+
 void RendererSceneCull::update_dirty_instances() const {
 	while (_instance_update_list.first()) {
 		_update_dirty_instance(_instance_update_list.first()->self());
 	}
 
+	if (indexer_refits_pending) {
+		uint32_t rid_count = scenario_owner.get_rid_count();
+		RID *rids = (RID *)alloca(sizeof(RID) * rid_count);
+		scenario_owner.fill_owned_buffer(rids);
+		for (uint32_t i = 0; i < rid_count; i++) {
+			_scenario_flush_indexer_refits(scenario_owner.get_or_null(rids[i]));
+		}
+		indexer_refits_pending = false;
+	}
+
 	// Update dirty resources after dirty instances as instance updates may affect resources.
 	RSG::utilities->update_dirty_resources();
 }
 
 void RendererSceneCull::update() {
+	instances_frustum_tested_in_frame = instances_frustum_tested.get();
+	instances_frustum_reused_in_frame = instances_frustum_reused.get();
+	instances_frustum_tested.set(0);
+	instances_frustum_reused.set(0);
+
 	//optimize bvhs
 
 	uint32_t rid_count = scenario_owner.get_rid_count();
@@ -4165,6 +4286,14 @@ void RendererSceneCull::update() {
 	render_particle_colliders();
 }
 
+uint64_t RendererSceneCull::get_instances_frustum_tested_in_frame() const {
+	return instances_frustum_tested_in_frame;
+}
+
+uint64_t RendererSceneCull::get_instances_frustum_reused_in_frame() const {
+	return instances_frustum_reused_in_frame;
+}
+
 bool RendererSceneCull::free(RID p_rid) {
 	if (p_rid.is_null()) {
 		return true;
@@ -4299,7 +4428,7 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	raster_occlusion_culling = memnew(RasterOcclusionCull);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4325,8 +4454,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (raster_occlusion_culling) {
+		memdelete(raster_occlusion_culling);
 	}
 
 	if (light_culler) {
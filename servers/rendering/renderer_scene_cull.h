@@ -38,6 +38,7 @@
 #include "core/templates/paged_array.h"
 #include "core/templates/pass_func.h"
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "servers/rendering/instance_uniforms.h"
 #include "servers/rendering/renderer_scene_occlusion_cull.h"
@@ -125,7 +126,8 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	// Software rasterizer used unless a module (such as raycast) provides another backend.
+	RendererSceneOcclusionCull *raster_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -295,6 +297,10 @@ public:
 		// This creates a delay for occlusion culling, which prevents flickering
 		// when jittering the raster occlusion projection.
 		uint64_t occlusion_timeout = 0;
+
+		// Set from Scenario::bounds_version each time the bounds stored at this array index change,
+		// so cached frustum test results older than this are known to be stale.
+		uint64_t bounds_version = 0;
 	};
 
 	struct InstanceVisibilityData {
@@ -352,6 +358,27 @@ public:
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
+		// Camera frustum test results of previous frames, per viewport. An instance is only
+		// tested again when the frustum or its bounds changed since the result was stored.
+		struct FrustumCullResult {
+			// Bounds version the result was computed with, 0 if the instance at this index wasn't tested yet.
+			// Instances skipped by other checks keep the version of their last test, so their result can't go stale.
+			uint64_t bounds_version = 0;
+			bool inside = false;
+		};
+
+		struct FrustumCullCache {
+			Vector<Plane> planes;
+			LocalVector<FrustumCullResult> results;
+		};
+
+		uint64_t bounds_version = 0;
+		HashMap<RID, FrustumCullCache> frustum_cull_caches;
+
+		// Geometry BVH updates coming from instances_set_transforms(), refitted in a single pass.
+		LocalVector<DynamicBVH::ID> indexer_refit_ids;
+		LocalVector<AABB> indexer_refit_aabbs;
+
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
 			indexers[INDEXER_VOLUMES].set_index(INDEXER_VOLUMES);
@@ -410,6 +437,7 @@ public:
 
 		Transform3D transform;
 		bool teleported = false;
+		bool batched_transform = false; // BVH update is deferred and refitted together with the rest of the batch.
 
 		float lod_bias;
 
@@ -1025,6 +1053,7 @@ public:
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_pivot_data(RID p_instance, float p_sorting_offset, bool p_use_aabb_center);
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform);
+	virtual void instances_set_transforms(const PackedInt64Array &p_instances, const PackedFloat32Array &p_transforms);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_override_material(RID p_instance, int p_surface, RID p_material);
@@ -1074,6 +1103,9 @@ public:
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance) const;
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance) const;
 	void _unpair_instance(Instance *p_instance);
+	void _scenario_flush_indexer_refits(Scenario *p_scenario) const;
+
+	mutable bool indexer_refits_pending = false;
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
@@ -1144,12 +1176,20 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		Scenario::FrustumCullResult *frustum_cache_results = nullptr;
 	};
 
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 	static void _scene_particles_set_view_axis(RID p_particles, const Vector3 &p_axis, const Vector3 &p_up_axis);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
+	_FORCE_INLINE_ bool _in_camera_frustum(const CullData &p_cull_data, uint64_t p_index, const InstanceData &p_instance_data, uint32_t &r_tested, uint32_t &r_reused);
+
+	// Instances whose camera frustum test was run or reused, accumulated while culling and latched each frame.
+	SafeNumeric<uint64_t> instances_frustum_tested;
+	SafeNumeric<uint64_t> instances_frustum_reused;
+	uint64_t instances_frustum_tested_in_frame = 0;
+	uint64_t instances_frustum_reused_in_frame = 0;
 
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
 
@@ -1395,6 +1435,9 @@ public:
 
 	virtual void update();
 
+	virtual uint64_t get_instances_frustum_tested_in_frame() const;
+	virtual uint64_t get_instances_frustum_reused_in_frame() const;
+
 	bool free(RID p_rid);
 
 	void set_scene_render(RendererSceneRender *p_scene_render);
@@ -38,6 +38,9 @@ class RendererSceneOcclusionCull {
 protected:
 	static RendererSceneOcclusionCull *singleton;
 
+	static Rect2 _get_viewport_rect(const Projection &p_cam_projection);
+	static Vector2 _get_jitter(const Rect2 &p_viewport_rect, const Size2i &p_buffer_size);
+
 public:
 	class HZBuffer {
 	protected:
@@ -297,6 +297,10 @@ uint64_t RenderingServerDefault::get_rendering_info(RenderingInfo p_info) {
 		return RSG::canvas_render->get_pipeline_compilations(PIPELINE_SOURCE_DRAW) + RSG::scene->get_pipeline_compilations(PIPELINE_SOURCE_DRAW);
 	} else if (p_info == RENDERING_INFO_PIPELINE_COMPILATIONS_SPECIALIZATION) {
 		return RSG::canvas_render->get_pipeline_compilations(PIPELINE_SOURCE_SPECIALIZATION) + RSG::scene->get_pipeline_compilations(PIPELINE_SOURCE_SPECIALIZATION);
+	} else if (p_info == RENDERING_INFO_TOTAL_INSTANCES_FRUSTUM_TESTED_IN_FRAME) {
+		return RSG::scene->get_instances_frustum_tested_in_frame();
+	} else if (p_info == RENDERING_INFO_TOTAL_INSTANCES_FRUSTUM_REUSED_IN_FRAME) {
+		return RSG::scene->get_instances_frustum_reused_in_frame();
 	}
 	return RSG::utilities->get_rendering_info(p_info);
 }
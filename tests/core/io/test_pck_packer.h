@@ -61,6 +61,11 @@ TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	CHECK_MESSAGE(
 			f->get_length() <= 500,
 			"The generated empty PCK file shouldn't be too large.");
+
+	CHECK(f->get_32() == PACK_HEADER_MAGIC);
+	CHECK_MESSAGE(
+			f->get_32() == PACK_FORMAT_VERSION_V3,
+			"A PCK file without compressed files should keep the version older runtimes can read.");
 }
 
 TEST_CASE("[PCKPacker] Pack empty with zero alignment invalid") {
@@ -116,4 +121,100 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Pack and read back compressed files") {
+	// Compressible, but not trivially so, and spanning several compression blocks.
+	Vector<uint8_t> data;
+	data.resize(PACK_COMPRESSED_BLOCK_SIZE * 5 + 1234);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = uint8_t((i / 7) ^ (i % 251));
+	}
+	const String source_path = TestUtils::get_temp_path("compressed_source.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data);
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	pck_packer.set_compress_files(true);
+	CHECK(pck_packer.is_compressing_files());
+	CHECK(pck_packer.add_file("pck_packer_compressed/data.bin", source_path) == OK);
+	CHECK(pck_packer.add_file("pck_packer_compressed/encrypted_data.bin", source_path, true) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes(output_pck_path).size() < data.size(),
+			"The PCK file should be smaller than the two files it holds.");
+	{
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_32() == PACK_HEADER_MAGIC);
+		CHECK_MESSAGE(
+				f->get_32() == PACK_FORMAT_VERSION_V4,
+				"A PCK file with compressed files should be marked as version 4.");
+	}
+
+	// Packs are registered through the singleton, so use it and remove the files afterwards.
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data);
+	REQUIRE(packed_data->add_pack(output_pck_path, true, 0) == OK);
+	CHECK(packed_data->get_size("res://pck_packer_compressed/data.bin") == data.size());
+
+	for (const char *path : { "res://pck_packer_compressed/data.bin", "res://pck_packer_compressed/encrypted_data.bin" }) {
+		Ref<FileAccess> f = packed_data->try_open_path(path);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == uint64_t(data.size()));
+		CHECK(f->get_buffer(data.size()) == data);
+		CHECK(f->eof_reached());
+
+		// Seeking and reading across block boundaries.
+		f->seek(PACK_COMPRESSED_BLOCK_SIZE - 10);
+		CHECK(f->get_8() == data[PACK_COMPRESSED_BLOCK_SIZE - 10]);
+		CHECK(f->get_buffer(20) == data.slice(PACK_COMPRESSED_BLOCK_SIZE - 9, PACK_COMPRESSED_BLOCK_SIZE + 11));
+		f->seek(123);
+		CHECK(f->get_buffer(PACK_COMPRESSED_BLOCK_SIZE * 4) == data.slice(123, 123 + PACK_COMPRESSED_BLOCK_SIZE * 4));
+		f->seek_end(-5);
+		CHECK(f->get_buffer(10) == data.slice(data.size() - 5));
+	}
+
+	packed_data->remove_path("res://pck_packer_compressed/data.bin");
+	packed_data->remove_path("res://pck_packer_compressed/encrypted_data.bin");
+	CHECK_FALSE(packed_data->has_path("res://pck_packer_compressed/data.bin"));
+}
+
+TEST_CASE("[PCKPacker] Overwrite and reload a loaded pack") {
+	const String source_path = TestUtils::get_temp_path("reloaded_source.txt");
+	const String output_pck_path = TestUtils::get_temp_path("output_reloaded.pck");
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data);
+
+	for (const String &contents : { String("First version of the file."), String("Second, longer version of the same file, stored at another offset.") }) {
+		{
+			Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_string(contents);
+		}
+
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+		CHECK(pck_packer.add_file("pck_packer_reloaded/padding.txt", source_path) == OK);
+		CHECK(pck_packer.add_file("pck_packer_reloaded/file.txt", source_path) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+
+		REQUIRE(packed_data->add_pack(output_pck_path, true, 0) == OK);
+		CHECK(packed_data->has_pack_files(output_pck_path));
+		Ref<FileAccess> f = packed_data->try_open_path("res://pck_packer_reloaded/file.txt");
+		REQUIRE(f.is_valid());
+		CHECK(f->get_as_utf8_string() == contents);
+	}
+
+	// The pack is released once none of its files are left.
+	packed_data->remove_path("res://pck_packer_reloaded/padding.txt");
+	CHECK(packed_data->has_pack_files(output_pck_path));
+	packed_data->remove_path("res://pck_packer_reloaded/file.txt");
+	CHECK_FALSE(packed_data->has_pack_files(output_pck_path));
+}
 } // namespace TestPCKPacker
@@ -573,6 +573,48 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Loading binary resources with many sub-resources using sub-threads") {
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Main");
+	Array children;
+	for (int i = 0; i < 100; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		PackedInt32Array payload;
+		payload.resize(1000 + i);
+		payload.fill(i);
+		child->set_meta("payload", payload);
+		if (i > 0) {
+			// Points to a sub-resource stored before this one.
+			child->set_meta("previous", children[i - 1]);
+		}
+		children.push_back(child);
+	}
+	resource->set_meta("children", children);
+
+	const String save_path = TestUtils::get_temp_path("resource_sub_threads.res");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+
+	REQUIRE(ResourceLoader::load_threaded_request(save_path, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+	const Ref<Resource> loaded = ResourceLoader::load_threaded_get(save_path);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_name() == "Main");
+
+	const Array loaded_children = loaded->get_meta("children");
+	REQUIRE(loaded_children.size() == 100);
+	bool all_match = true;
+	for (int i = 0; i < 100; i++) {
+		const Ref<Resource> child = loaded_children[i];
+		const PackedInt32Array payload = child->get_meta("payload");
+		all_match &= child->get_name() == vformat("Child %d", i);
+		all_match &= payload.size() == 1000 + i && payload[0] == i && payload[payload.size() - 1] == i;
+		if (i > 0) {
+			all_match &= Ref<Resource>(child->get_meta("previous")) == Ref<Resource>(loaded_children[i - 1]);
+		}
+	}
+	CHECK_MESSAGE(all_match, "All sub-resources should be loaded with their properties and references.");
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
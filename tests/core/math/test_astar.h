@@ -31,6 +31,9 @@
 #pragma once
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
+#include "core/os/os.h"
+#include "core/variant/typed_array.h"
 
 #include "tests/test_macros.h"
 
@@ -356,4 +359,129 @@ TEST_CASE("[Stress][AStar3D] Find paths") {
 		CHECK_MESSAGE(match, "Found all paths.");
 	}
 }
+
+static real_t get_id_path_length(const TypedArray<Vector2i> &p_path) {
+	real_t length = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += Vector2(Vector2i(p_path[i]) - Vector2i(p_path[i - 1])).length();
+	}
+	return length;
+}
+
+TEST_CASE("[AStarGrid2D] Jumping should find paths as short as regular search") {
+	// Wider than 64 cells and offset, so row scans cross 64-bit words of the solid mask.
+	const Rect2i region = Rect2i(-3, 2, 150, 24);
+	Math::seed(0);
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_region(region);
+	grid->update();
+
+	for (int layout = 0; layout < 4; layout++) {
+		grid->fill_solid_region(region, false);
+		for (int i = 0; i < 400 * layout; i++) {
+			grid->set_point_solid(Vector2i(region.position.x + Math::rand() % region.size.x, region.position.y + Math::rand() % region.size.y));
+		}
+		// Solid runs spanning word boundaries of the mask.
+		for (int y = region.position.y; y < region.get_end().y; y += 3) {
+			grid->fill_solid_region(Rect2i(region.position.x + 55 + y % 7, y, 12, 1));
+		}
+
+		for (int query = 0; query < 10; query++) {
+			Vector2i from = Vector2i(region.position.x + Math::rand() % region.size.x, region.position.y + Math::rand() % region.size.y);
+			Vector2i to = Vector2i(region.position.x + Math::rand() % region.size.x, region.position.y + Math::rand() % region.size.y);
+			if (query == 0) {
+				// Scan to the left across the whole region.
+				from = Vector2i(region.get_end().x - 1, region.position.y + 1);
+				to = Vector2i(region.position.x, region.get_end().y - 2);
+			}
+			grid->set_point_solid(from, false);
+			grid->set_point_solid(to, false);
+
+			for (int mode = 0; mode < AStarGrid2D::DIAGONAL_MODE_MAX; mode++) {
+				grid->set_diagonal_mode(AStarGrid2D::DiagonalMode(mode));
+
+				grid->set_jumping_enabled(false);
+				const TypedArray<Vector2i> regular = grid->get_id_path(from, to);
+				grid->set_jumping_enabled(true);
+				const TypedArray<Vector2i> jumping = grid->get_id_path(from, to);
+
+				CHECK(regular.is_empty() == jumping.is_empty());
+				if (!regular.is_empty() && !jumping.is_empty()) {
+					CHECK(Vector2i(jumping.front()) == from);
+					CHECK(Vector2i(jumping.back()) == to);
+					CHECK(get_id_path_length(jumping) == doctest::Approx(get_id_path_length(regular)).epsilon(0.001));
+				}
+			}
+		}
+	}
+}
+
+// Carves a perfect maze into the grid. Corridors run along even coordinates, walls fill the rest.
+static void carve_maze(Ref<AStarGrid2D> p_grid, int32_t p_size) {
+	const int32_t cells = p_size / 2;
+	const Vector2i directions[4] = { Vector2i(1, 0), Vector2i(-1, 0), Vector2i(0, 1), Vector2i(0, -1) };
+	LocalVector<bool> visited;
+	visited.resize_initialized(cells * cells);
+	LocalVector<Vector2i> stack;
+
+	p_grid->fill_solid_region(p_grid->get_region());
+	p_grid->set_point_solid(Vector2i(), false);
+	visited[0] = true;
+	stack.push_back(Vector2i());
+
+	while (!stack.is_empty()) {
+		const Vector2i cell = stack[stack.size() - 1];
+		Vector2i options[4];
+		int option_count = 0;
+		for (const Vector2i &dir : directions) {
+			const Vector2i next = cell + dir;
+			if (next.x >= 0 && next.y >= 0 && next.x < cells && next.y < cells && !visited[next.y * cells + next.x]) {
+				options[option_count++] = next;
+			}
+		}
+		if (option_count == 0) {
+			stack.remove_at(stack.size() - 1);
+			continue;
+		}
+		const Vector2i next = options[Math::rand() % option_count];
+		visited[next.y * cells + next.x] = true;
+		p_grid->set_point_solid(cell + next, false);
+		p_grid->set_point_solid(next * 2, false);
+		stack.push_back(next);
+	}
+}
+
+TEST_CASE("[AStarGrid2D][Benchmark] Jumping against regular search on 1024x1024 mazes" * doctest::skip()) {
+	const int32_t size = 1024;
+	Math::seed(0);
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_region(Rect2i(0, 0, size, size));
+	grid->set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_NEVER);
+	grid->set_default_compute_heuristic(AStarGrid2D::HEURISTIC_MANHATTAN);
+	grid->set_default_estimate_heuristic(AStarGrid2D::HEURISTIC_MANHATTAN);
+	grid->update();
+
+	for (int maze = 0; maze < 4; maze++) {
+		carve_maze(grid, size);
+		const Vector2i from = Vector2i();
+		const Vector2i to = Vector2i(size - 2, size - 2);
+
+		grid->set_jumping_enabled(false);
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		const TypedArray<Vector2i> regular = grid->get_id_path(from, to);
+		const uint64_t regular_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+		grid->set_jumping_enabled(true);
+		start = OS::get_singleton()->get_ticks_usec();
+		const TypedArray<Vector2i> jumping = grid->get_id_path(from, to);
+		const uint64_t jumping_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+		print_line(vformat("Maze %d: regular search %.3f ms (%d points), jumping %.3f ms (%d points).", maze, regular_usec / 1000.0, regular.size(), jumping_usec / 1000.0, jumping.size()));
+		REQUIRE_FALSE(regular.is_empty());
+		REQUIRE_FALSE(jumping.is_empty());
+		CHECK(Vector2i(jumping.back()) == to);
+	}
+}
 } // namespace TestAStar
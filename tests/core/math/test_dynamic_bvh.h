@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*  test_dynamic_bvh.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/dynamic_bvh.h"
+
+#include "tests/test_macros.h"
+
+namespace TestDynamicBVH {
+
+struct CollectLeaves {
+	Vector<int> leaves;
+
+	bool operator()(void *p_data) {
+		leaves.push_back((int)(intptr_t)p_data);
+		return false; // Keep searching.
+	}
+};
+
+static void check_aabb_queries(DynamicBVH &p_bvh, const LocalVector<AABB> &p_boxes) {
+	for (int query = 0; query < 20; query++) {
+		const AABB query_box = AABB(Vector3(Math::randf() * 100, Math::randf() * 100, Math::randf() * 100), Vector3(10, 10, 10));
+
+		CollectLeaves result;
+		p_bvh.aabb_query(query_box, result);
+		result.leaves.sort();
+
+		Vector<int> expected;
+		for (uint32_t i = 0; i < p_boxes.size(); i++) {
+			if (p_boxes[i].intersects_inclusive(query_box)) {
+				expected.push_back(i);
+			}
+		}
+		CHECK(result.leaves == expected);
+	}
+}
+
+TEST_CASE("[DynamicBVH] Refit keeps queries exact after many small moves") {
+	const int count = 200;
+	Math::seed(0);
+
+	DynamicBVH bvh;
+	LocalVector<DynamicBVH::ID> ids;
+	LocalVector<AABB> boxes;
+	LocalVector<Vector3> velocities;
+	for (int i = 0; i < count; i++) {
+		const AABB box = AABB(Vector3(Math::randf() * 100, Math::randf() * 100, Math::randf() * 100), Vector3(1, 1, 1));
+		ids.push_back(bvh.insert(box, (void *)(intptr_t)i));
+		boxes.push_back(box);
+		// Small steps every frame, which add up to leaving the original bounds.
+		velocities.push_back(Vector3(Math::randf() - 0.5, Math::randf() - 0.5, Math::randf() - 0.5) * 0.1);
+	}
+	check_aabb_queries(bvh, boxes);
+
+	for (int frame = 0; frame < 300; frame++) {
+		for (int i = 0; i < count; i++) {
+			boxes[i].position += velocities[i];
+		}
+		// Some objects jump far away.
+		if (frame % 50 == 25) {
+			for (int i = 0; i < count; i += 10) {
+				boxes[i].position = Vector3(Math::randf() * 100, Math::randf() * 100, Math::randf() * 100);
+			}
+		}
+		bvh.refit(ids.ptr(), boxes.ptr(), count);
+
+		if (frame % 50 == 0) {
+			check_aabb_queries(bvh, boxes);
+		}
+	}
+	check_aabb_queries(bvh, boxes);
+	CHECK(bvh.get_leaf_count() == count);
+
+	// Refitting a subset with repeated entries must work too.
+	const DynamicBVH::ID subset_ids[3] = { ids[3], ids[7], ids[3] };
+	boxes[3].position = Vector3(50, 50, 50);
+	boxes[7].position += Vector3(0.01, 0, 0);
+	const AABB subset_boxes[3] = { AABB(Vector3(10, 10, 10), Vector3(1, 1, 1)), boxes[7], boxes[3] };
+	bvh.refit(subset_ids, subset_boxes, 3);
+	check_aabb_queries(bvh, boxes);
+
+	for (const DynamicBVH::ID &id : ids) {
+		bvh.remove(id);
+	}
+	CHECK(bvh.is_empty());
+}
+
+} // namespace TestDynamicBVH
@@ -0,0 +1,145 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+static void _fill(uint8_t *p_mem, size_t p_bytes, uint8_t p_seed) {
+	for (size_t i = 0; i < p_bytes; i++) {
+		p_mem[i] = uint8_t(p_seed + i);
+	}
+}
+
+static bool _check(const uint8_t *p_mem, size_t p_bytes, uint8_t p_seed) {
+	for (size_t i = 0; i < p_bytes; i++) {
+		if (p_mem[i] != uint8_t(p_seed + i)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[Memory] Reallocation keeps contents") {
+	// Grow and shrink through small and large sizes.
+	const size_t sizes[] = { 0, 1, 16, 17, 100, 130, 600, 1024, 1025, 5000, 900, 40, 3 };
+
+	for (int pad = 0; pad < 2; pad++) {
+		uint8_t *mem = (uint8_t *)Memory::alloc_static(8, pad);
+		_fill(mem, 8, 42);
+		size_t valid = 8;
+		bool contents_kept = true;
+		for (size_t size : sizes) {
+			if (size == 0) {
+				continue;
+			}
+			mem = (uint8_t *)Memory::realloc_static(mem, size, pad);
+			REQUIRE(mem != nullptr);
+			contents_kept = contents_kept && _check(mem, MIN(valid, size), 42);
+			_fill(mem, size, 42);
+			valid = size;
+		}
+		CHECK_MESSAGE(contents_kept, "Contents should be kept when reallocating.");
+		Memory::free_static(mem, pad);
+	}
+}
+
+TEST_CASE("[Memory] Zeroed allocation") {
+	// Dirty some blocks first, so recycled memory gets reused.
+	for (size_t size = 1; size < 2048; size += 61) {
+		uint8_t *mem = (uint8_t *)Memory::alloc_static(size);
+		_fill(mem, size, 1);
+		Memory::free_static(mem);
+	}
+
+	bool zeroed = true;
+	for (size_t size = 1; size < 2048; size += 61) {
+		uint8_t *mem = (uint8_t *)Memory::alloc_static_zeroed(size);
+		for (size_t i = 0; i < size; i++) {
+			zeroed = zeroed && mem[i] == 0;
+		}
+		Memory::free_static(mem);
+	}
+	CHECK_MESSAGE(zeroed, "Zeroed allocations should not contain stale data.");
+}
+
+struct CrossThreadData {
+	LocalVector<uint8_t *> blocks;
+	bool valid = true;
+};
+
+static void _free_blocks(void *p_userdata) {
+	CrossThreadData *data = (CrossThreadData *)p_userdata;
+	for (uint32_t i = 0; i < data->blocks.size(); i++) {
+		const size_t size = (i * 37) % 1500 + 1;
+		data->valid = data->valid && _check(data->blocks[i], size, uint8_t(i));
+		Memory::free_static(data->blocks[i]);
+	}
+}
+
+TEST_CASE("[Memory] Free from another thread") {
+	CrossThreadData data;
+	for (uint32_t i = 0; i < 2000; i++) {
+		const size_t size = (i * 37) % 1500 + 1;
+		uint8_t *mem = (uint8_t *)Memory::alloc_static(size);
+		_fill(mem, size, uint8_t(i));
+		data.blocks.push_back(mem);
+	}
+
+#ifdef SMALL_ALLOCATOR_ENABLED
+	uint64_t frees_before = 0;
+	for (uint32_t i = 0; i < Memory::get_size_class_count(); i++) {
+		frees_before += Memory::get_size_class_stats(i).frees;
+	}
+#endif
+
+	Thread thread;
+	thread.start(_free_blocks, &data);
+	thread.wait_to_finish();
+	CHECK_MESSAGE(data.valid, "Blocks should be intact when freed by another thread.");
+
+#ifdef SMALL_ALLOCATOR_ENABLED
+	// The exiting thread gives its cache back, including its counters.
+	uint64_t frees_after = 0;
+	for (uint32_t i = 0; i < Memory::get_size_class_count(); i++) {
+		CHECK(Memory::get_size_class_stats(i).size > 0);
+		frees_after += Memory::get_size_class_stats(i).frees;
+	}
+	CHECK_MESSAGE(frees_after > frees_before, "Frees of the other thread should be counted.");
+#endif
+}
+
+} // namespace TestMemory
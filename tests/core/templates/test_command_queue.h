@@ -442,6 +442,56 @@ TEST_CASE("[CommandQueue] Test Queue Lapping") {
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
 
+class CommandCounter {
+public:
+	int count = 0;
+
+	void func1(Transform3D t) {
+		count++;
+	}
+	void func3(Transform3D t1, Transform3D t2, Transform3D t3, Transform3D t4, Transform3D t5, Transform3D t6) {
+		count++;
+	}
+};
+
+TEST_CASE("[CommandQueue] Test Queue Blocks and Stats") {
+	CommandCounter counter;
+	CommandQueueMT queue;
+
+	// Enough commands to span several blocks.
+	const int command_count = 4096;
+	for (int i = 0; i < command_count; i++) {
+		queue.push(&counter, &CommandCounter::func3, Transform3D(), Transform3D(), Transform3D(), Transform3D(), Transform3D(), Transform3D());
+	}
+	CommandQueueMT::Stats stats = queue.get_stats();
+	CHECK_MESSAGE(stats.peak_size >= command_count * 6 * sizeof(Transform3D),
+			"Peak size should account for every queued command.");
+	CHECK_MESSAGE(counter.count == 0,
+			"No command should run before flushing.");
+
+	queue.flush_all();
+	CHECK_MESSAGE(counter.count == command_count,
+			"Flushing should run the commands of every block.");
+	stats = queue.get_stats();
+	CHECK_MESSAGE(stats.max_flush_latency_usec >= stats.last_flush_latency_usec,
+			"Max flush latency should include the last flush.");
+
+	// Reusing the recycled blocks, peak size must stay the same.
+	const uint64_t peak_size = stats.peak_size;
+	for (int i = 0; i < command_count / 2; i++) {
+		queue.push(&counter, &CommandCounter::func1, Transform3D());
+	}
+	queue.flush_all();
+	CHECK_MESSAGE(counter.count == command_count + command_count / 2,
+			"Commands pushed after a flush should run.");
+	CHECK_MESSAGE(queue.get_stats().peak_size == peak_size,
+			"A smaller batch should not change the peak size.");
+
+	queue.reset_stats();
+	CHECK_MESSAGE(queue.get_stats().peak_size == 0,
+			"Resetting stats should clear the peak size.");
+}
+
 TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	const char *COMMAND_QUEUE_SETTING = "memory/limits/command_queue/multithreading_queue_size_kb";
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING, 1);
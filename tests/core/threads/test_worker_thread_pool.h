@@ -106,6 +106,112 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static void static_nested_leaf_test(void *p_arg) {
+	counter[(uint64_t)p_arg].increment();
+}
+
+static void static_nested_group_test(void *p_arg, uint32_t p_index) {
+	// Posted from a pool thread, so these land in its local queue and are either run by it while waiting or stolen.
+	const int leaves = (int)(uintptr_t)p_arg;
+	WorkerThreadPool::TaskID *leaf_tasks = (WorkerThreadPool::TaskID *)alloca(sizeof(WorkerThreadPool::TaskID) * leaves);
+	for (int i = 0; i < leaves; i++) {
+		leaf_tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_leaf_test, (void *)(uintptr_t)p_index, true);
+	}
+	for (int i = 0; i < leaves; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(leaf_tasks[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Process many fine-grained tasks posted from pool threads") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 6.0f));
+		// Enough leaves to overflow a local queue now and then.
+		const int leaves = Math::pow(2.0f, Math::random(0.0f, 9.0f));
+
+		counter.clear();
+		counter.resize(count);
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_group_test, (void *)(uintptr_t)leaves, count, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+		bool all_run_once = true;
+		for (int i = 0; i < count; i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == leaves;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+static void static_benchmark_group_test(void *p_arg, uint32_t p_index) {
+	counter[p_index & 0xff].increment();
+}
+
+TEST_CASE("[WorkerThreadPool][Benchmark] Stress fine-grained group and nested tasks" * doctest::skip()) {
+	const int frames = 2000;
+	const int elements = 4096;
+	counter.clear();
+	counter.resize(256);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < frames; i++) {
+		// Many small groups in a row, like the culling and process groups of a frame.
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_benchmark_group_test, nullptr, elements, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	uint64_t groups_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < frames / 10; i++) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_group_test, (void *)(uintptr_t)64, 256, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	uint64_t nested_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int total = 0;
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		total += counter[i].get();
+	}
+	CHECK(total == frames * elements + (frames / 10) * 256 * 64);
+
+	MESSAGE("Threads: ", WorkerThreadPool::get_singleton()->get_thread_count());
+	MESSAGE("Groups: ", frames, " x ", elements, " elements in ", groups_usec / 1000.0, " ms.");
+	MESSAGE("Nested: ", frames / 10, " x 256 tasks posting 64 tasks each in ", nested_usec / 1000.0, " ms.");
+}
+
+static void static_dependency_test(void *p_arg) {
+	// Each stage records the value the previous stage left, then advances it.
+	counter[(uint64_t)p_arg].set(counter[0].get());
+	counter[0].increment();
+}
+static void static_dependency_group_test(void *p_arg, uint32_t p_index) {
+	counter[0].increment();
+}
+TEST_CASE("[WorkerThreadPool] Run tasks after their dependencies") {
+	for (int iterations = 0; iterations < 200; iterations++) {
+		const bool low_priority = Math::rand() % 2;
+		const int elements = Math::pow(2.0f, Math::random(0.0f, 6.0f));
+
+		counter.clear();
+		counter.resize(4);
+
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		WorkerThreadPool::TaskID first = pool->add_native_task(static_dependency_test, (void *)1, !low_priority);
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(static_dependency_group_test, nullptr, elements, -1, !low_priority);
+		WorkerThreadPool::TaskID second = pool->add_native_dependent_task(static_dependency_test, (void *)2, Span<WorkerThreadPool::TaskID>(&first, 1), low_priority);
+		WorkerThreadPool::TaskID after_both[] = { second, group };
+		WorkerThreadPool::TaskID third = pool->add_native_dependent_task(static_dependency_test, (void *)3, after_both, !low_priority);
+
+		pool->wait_for_task_completion(third);
+		pool->wait_for_task_completion(second);
+		pool->wait_for_task_completion(first);
+		pool->wait_for_group_task_completion(group);
+
+		CHECK(counter[0].get() == elements + 3);
+		CHECK(counter[2].get() > counter[1].get());
+		CHECK(counter[3].get() == elements + 2);
+	}
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
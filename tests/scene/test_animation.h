@@ -308,4 +308,87 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[Animation] Sample compressed tracks") {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(10.0);
+	const int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(position_track, NodePath("Enemy:position"));
+	const int rotation_track = animation->add_track(Animation::TYPE_ROTATION_3D);
+	animation->track_set_path(rotation_track, NodePath("Enemy:rotation"));
+	const int blend_shape_track = animation->add_track(Animation::TYPE_BLEND_SHAPE);
+	animation->track_set_path(blend_shape_track, NodePath("Enemy:smile"));
+	const int value_track = animation->add_track(Animation::TYPE_VALUE);
+	animation->track_set_path(value_track, NodePath("Enemy:visible"));
+	for (int i = 0; i <= 200; i++) {
+		const double time = i * 0.05;
+		animation->position_track_insert_key(position_track, time, Vector3(Math::sin(time), Math::cos(time * 3.0), time));
+		animation->rotation_track_insert_key(rotation_track, time, Quaternion(Vector3(0, 1, 0), Math::sin(time)));
+		animation->blend_shape_track_insert_key(blend_shape_track, time, Math::sin(time * 2.0));
+	}
+	animation->track_insert_key(value_track, 0.0, true);
+
+	// Small pages, so sampling has to move between them.
+	animation->compress(512);
+	REQUIRE(animation->track_is_compressed(position_track));
+	REQUIRE(animation->track_is_compressed(rotation_track));
+	REQUIRE(animation->track_is_compressed(blend_shape_track));
+
+	LocalVector<Animation::CompressedTrackSample> samples;
+	LocalVector<Animation::CompressedTrackCursor> cursors;
+
+	// Playing forward, then jumping around, cursors must give the same results as sampling from scratch.
+	LocalVector<double> times;
+	for (int i = 0; i <= 600; i++) {
+		times.push_back(i / 60.0);
+	}
+	times.push_back(2.5);
+	times.push_back(9.99);
+	times.push_back(0.0);
+	times.push_back(7.123);
+	times.push_back(7.0);
+
+	for (double time : times) {
+		REQUIRE(animation->sample_compressed_tracks(time, samples, cursors));
+		REQUIRE(samples.size() == 4);
+		CHECK_FALSE(samples[value_track].valid);
+
+		Vector3 position;
+		REQUIRE(animation->try_position_track_interpolate(position_track, time, &position) == OK);
+		CHECK(samples[position_track].valid);
+		CHECK(samples[position_track].value == position);
+
+		Quaternion rotation;
+		REQUIRE(animation->try_rotation_track_interpolate(rotation_track, time, &rotation) == OK);
+		CHECK(samples[rotation_track].valid);
+		CHECK(samples[rotation_track].rotation == rotation);
+
+		float blend = 0.0;
+		REQUIRE(animation->try_blend_shape_track_interpolate(blend_shape_track, time, &blend) == OK);
+		CHECK(samples[blend_shape_track].valid);
+		CHECK(samples[blend_shape_track].value.x == blend);
+
+		// Compression is lossy, but should stay close to the original curve.
+		CHECK(position.distance_to(Vector3(Math::sin(time), Math::cos(time * 3.0), time)) < 0.05);
+	}
+
+	// Tracks left out of the mask are not sampled, the others still resume from their cursors.
+	bool track_mask[4] = {};
+	track_mask[rotation_track] = true;
+	for (double time : times) {
+		REQUIRE(animation->sample_compressed_tracks(time, samples, cursors, track_mask));
+		CHECK_FALSE(samples[position_track].valid);
+		CHECK_FALSE(samples[blend_shape_track].valid);
+		CHECK_FALSE(samples[value_track].valid);
+
+		Quaternion rotation;
+		REQUIRE(animation->try_rotation_track_interpolate(rotation_track, time, &rotation) == OK);
+		CHECK(samples[rotation_track].valid);
+		CHECK(samples[rotation_track].rotation == rotation);
+	}
+
+	Ref<Animation> uncompressed = memnew(Animation);
+	uncompressed->add_track(Animation::TYPE_POSITION_3D);
+	CHECK_FALSE(uncompressed->sample_compressed_tracks(0.0, samples, cursors));
+}
+
 } // namespace TestAnimation
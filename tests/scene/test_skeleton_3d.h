@@ -33,9 +33,47 @@
 #include "tests/test_macros.h"
 
 #include "scene/3d/skeleton_3d.h"
+#include "scene/main/window.h"
 
 namespace TestSkeleton3D {
 
+class SkeletonSignalRecorder : public Object {
+public:
+	Vector<String> events;
+
+	void record(const String &p_event) {
+		events.push_back(p_event);
+	}
+};
+
+class SkeletonBoneListChangedHandler : public Object {
+public:
+	ObjectID target;
+	Node *new_parent = nullptr;
+
+	void free_target() {
+		Object *object = ObjectDB::get_instance(target);
+		if (object) {
+			memdelete(object);
+		}
+	}
+
+	void reparent_target() {
+		Node *node = ObjectDB::get_instance<Node>(target);
+		if (node) {
+			node->reparent(new_parent);
+		}
+	}
+
+	void add_bone_to_target() {
+		Skeleton3D *skeleton = ObjectDB::get_instance<Skeleton3D>(target);
+		if (skeleton) {
+			int bone = skeleton->add_bone("added");
+			skeleton->set_bone_parent(bone, 1);
+		}
+	}
+};
+
 TEST_CASE("[Skeleton3D] Test per-bone meta") {
 	Skeleton3D *skeleton = memnew(Skeleton3D);
 	skeleton->add_bone("root");
@@ -72,4 +110,151 @@ TEST_CASE("[Skeleton3D] Test per-bone meta") {
 	skeleton->set_bone_meta(0, "non-existing-key", Variant());
 	memdelete(skeleton);
 }
+
+TEST_CASE("[Skeleton3D] Global poses of bones added out of hierarchy order") {
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	// Children are added before their parents on purpose.
+	skeleton->add_bone("tip");
+	skeleton->add_bone("root");
+	skeleton->add_bone("middle");
+	skeleton->add_bone("branch");
+	skeleton->set_bone_parent(0, 2);
+	skeleton->set_bone_parent(2, 1);
+	skeleton->set_bone_parent(3, 1);
+
+	const Transform3D root_pose = Transform3D(Basis(Vector3(0, 1, 0), Math::PI / 2), Vector3(1, 0, 0));
+	const Transform3D middle_pose = Transform3D(Basis(), Vector3(0, 2, 0));
+	const Transform3D tip_pose = Transform3D(Basis().scaled(Vector3(2, 2, 2)), Vector3(0, 0, 3));
+	for (int i = 0; i < skeleton->get_bone_count(); i++) {
+		skeleton->set_bone_rest(i, Transform3D(Basis(), Vector3(0, 0, 1)));
+	}
+	skeleton->set_bone_pose(1, root_pose);
+	skeleton->set_bone_pose(2, middle_pose);
+	skeleton->set_bone_pose(0, tip_pose);
+
+	// Lazy evaluation of a single bone.
+	CHECK(skeleton->get_bone_global_pose(0).is_equal_approx(root_pose * middle_pose * tip_pose));
+
+	// Evaluation of all dirty bones in a single pass.
+	skeleton->set_bone_pose(2, tip_pose);
+	skeleton->force_update_all_bone_transforms();
+	CHECK(skeleton->get_bone_global_pose(1).is_equal_approx(root_pose));
+	CHECK(skeleton->get_bone_global_pose(2).is_equal_approx(root_pose * tip_pose));
+	CHECK(skeleton->get_bone_global_pose(0).is_equal_approx(root_pose * tip_pose * tip_pose));
+	CHECK(skeleton->get_bone_global_pose(3).is_equal_approx(root_pose * Transform3D(Basis(), Vector3(0, 0, 1))));
+
+	// Disabled bones use their rest.
+	skeleton->set_bone_enabled(2, false);
+	skeleton->force_update_all_bone_transforms();
+	CHECK(skeleton->get_bone_global_pose(0).is_equal_approx(root_pose * Transform3D(Basis(), Vector3(0, 0, 1)) * tip_pose));
+	CHECK(skeleton->get_bone_global_rest(0).is_equal_approx(Transform3D(Basis(), Vector3(0, 0, 3))));
+
+	memdelete(skeleton);
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Batched global pose update of several skeletons") {
+	Skeleton3D *skeletons[2];
+	for (Skeleton3D *&skeleton : skeletons) {
+		skeleton = memnew(Skeleton3D);
+		skeleton->add_bone("root");
+		skeleton->add_bone("child");
+		skeleton->set_bone_parent(1, 0);
+		SceneTree::get_singleton()->get_root()->add_child(skeleton);
+	}
+	SceneTree::get_singleton()->process(0);
+
+	SkeletonSignalRecorder *recorder = memnew(SkeletonSignalRecorder);
+	const String names[2] = { "A", "B" };
+	for (int i = 0; i < 2; i++) {
+		skeletons[i]->connect(SceneStringName(pose_updated), callable_mp(recorder, &SkeletonSignalRecorder::record).bind(names[i] + " pose_updated"));
+		skeletons[i]->connect(SceneStringName(skeleton_updated), callable_mp(recorder, &SkeletonSignalRecorder::record).bind(names[i] + " skeleton_updated"));
+	}
+
+	// Both skeletons are queued in the same frame, and their global poses calculated together.
+	const Transform3D root_poses[2] = { Transform3D(Basis(), Vector3(1, 0, 0)), Transform3D(Basis(Vector3(0, 1, 0), Math::PI / 2), Vector3(0, 0, 2)) };
+	const Transform3D child_pose = Transform3D(Basis(), Vector3(0, 3, 0));
+	for (int i = 0; i < 2; i++) {
+		skeletons[i]->set_bone_pose(0, root_poses[i]);
+		skeletons[i]->set_bone_pose(1, child_pose);
+	}
+	SceneTree::get_singleton()->process(0);
+
+	// Each skeleton emits its signals in its own update, not when the first one calculates the batch.
+	const Vector<String> expected_events = { "A pose_updated", "A skeleton_updated", "B pose_updated", "B skeleton_updated" };
+	CHECK(recorder->events == expected_events);
+
+	for (int i = 0; i < 2; i++) {
+		CHECK(skeletons[i]->get_bone_global_pose(0).is_equal_approx(root_poses[i]));
+		CHECK(skeletons[i]->get_bone_global_pose(1).is_equal_approx(root_poses[i] * child_pose));
+	}
+
+	for (Skeleton3D *skeleton : skeletons) {
+		memdelete(skeleton);
+	}
+	memdelete(recorder);
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Batched global pose update when a bone_list_changed handler changes another skeleton") {
+	Node3D *other_parent = memnew(Node3D);
+	SceneTree::get_singleton()->get_root()->add_child(other_parent);
+
+	Skeleton3D *first = memnew(Skeleton3D);
+	Skeleton3D *second = memnew(Skeleton3D);
+	for (Skeleton3D *skeleton : { first, second }) {
+		skeleton->add_bone("root");
+		skeleton->add_bone("child");
+		skeleton->set_bone_parent(1, 0);
+		SceneTree::get_singleton()->get_root()->add_child(skeleton);
+	}
+	SceneTree::get_singleton()->process(0);
+
+	SkeletonBoneListChangedHandler *handler = memnew(SkeletonBoneListChangedHandler);
+	handler->target = second->get_instance_id();
+	handler->new_parent = other_parent;
+
+	const Transform3D root_pose = Transform3D(Basis(), Vector3(1, 0, 0));
+	const Transform3D child_pose = Transform3D(Basis(), Vector3(0, 3, 0));
+
+	// The first skeleton rebuilds its bone list in the batch, and its handler changes the second skeleton before the global poses are calculated.
+	auto queue_both = [&]() {
+		first->add_bone("extra");
+		second->set_bone_pose(0, root_pose);
+		second->set_bone_pose(1, child_pose);
+	};
+
+	SUBCASE("Freed") {
+		first->connect(SNAME("bone_list_changed"), callable_mp(handler, &SkeletonBoneListChangedHandler::free_target), Object::CONNECT_ONE_SHOT);
+		queue_both();
+		SceneTree::get_singleton()->process(0);
+		CHECK(ObjectDB::get_instance(handler->target) == nullptr);
+		second = nullptr;
+	}
+
+	SUBCASE("Reparented") {
+		first->connect(SNAME("bone_list_changed"), callable_mp(handler, &SkeletonBoneListChangedHandler::reparent_target), Object::CONNECT_ONE_SHOT);
+		queue_both();
+		SceneTree::get_singleton()->process(0);
+		CHECK(second->get_parent() == other_parent);
+		CHECK(second->get_bone_global_pose(1).is_equal_approx(root_pose * child_pose));
+	}
+
+	SUBCASE("Bones added") {
+		first->connect(SNAME("bone_list_changed"), callable_mp(handler, &SkeletonBoneListChangedHandler::add_bone_to_target), Object::CONNECT_ONE_SHOT);
+		queue_both();
+		SceneTree::get_singleton()->process(0);
+		REQUIRE(second->get_bone_count() == 3);
+		CHECK(second->get_bone_global_pose(1).is_equal_approx(root_pose * child_pose));
+		CHECK(second->get_bone_global_pose(2).is_equal_approx(root_pose * child_pose));
+	}
+
+	CHECK(first->get_bone_count() == 3);
+	CHECK(first->get_bone_global_pose(1).is_equal_approx(Transform3D()));
+
+	memdelete(first);
+	if (second) {
+		memdelete(second);
+	}
+	memdelete(other_parent);
+	memdelete(handler);
+}
 } // namespace TestSkeleton3D
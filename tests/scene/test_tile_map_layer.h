@@ -0,0 +1,289 @@
+/**************************************************************************/
+/*  test_tile_map_layer.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/marshalls.h"
+#include "scene/2d/tile_map_layer.h"
+#include "scene/main/window.h"
+#include "scene/resources/image_texture.h"
+
+#include "tests/test_macros.h"
+
+class TestTileMapLayerInternalsAccessor {
+public:
+	static LocalVector<RID> get_body_rids(const TileMapLayer *p_layer) {
+		LocalVector<RID> rids;
+		for (const KeyValue<RID, Vector2i> &kv : p_layer->bodies_coords) {
+			rids.push_back(kv.key);
+		}
+		return rids;
+	}
+};
+
+namespace TestTileMapLayer {
+
+static Ref<TileSet> create_tile_set_with_collision() {
+	Ref<TileSet> tile_set;
+	tile_set.instantiate();
+	tile_set->add_physics_layer();
+
+	Ref<TileSetAtlasSource> atlas_source;
+	atlas_source.instantiate();
+	atlas_source->set_texture(ImageTexture::create_from_image(Image::create_empty(16, 16, false, Image::FORMAT_RGBA8)));
+	atlas_source->set_texture_region_size(Vector2i(16, 16));
+	tile_set->add_source(atlas_source, 0);
+
+	atlas_source->create_tile(Vector2i());
+	TileData *tile_data = atlas_source->get_tile_data(Vector2i(), 0);
+	tile_data->add_collision_polygon(0);
+	tile_data->set_collision_polygon_points(0, 0, { Vector2(-8, -8), Vector2(8, -8), Vector2(8, 8), Vector2(-8, 8) });
+
+	return tile_set;
+}
+
+TEST_CASE("[TileMapLayer] Cell storage across chunks") {
+	CellDataMap cells;
+	CHECK(cells.is_empty());
+	CHECK(cells.begin() == cells.end());
+
+	// Cells around chunk boundaries, including negative coords.
+	const Vector2i coords[] = { Vector2i(0, 0), Vector2i(-1, -1), Vector2i(CellDataMap::CHUNK_SIZE - 1, 0), Vector2i(CellDataMap::CHUNK_SIZE, 0), Vector2i(-CellDataMap::CHUNK_SIZE, 3), Vector2i(-CellDataMap::CHUNK_SIZE - 1, 3), Vector2i(1000, -1000) };
+	for (const Vector2i &c : coords) {
+		CellData cell_data;
+		cell_data.coords = c;
+		cell_data.cell.source_id = c.x;
+		cells.insert(c, cell_data);
+	}
+	CHECK(cells.size() == std::size(coords));
+
+	for (const Vector2i &c : coords) {
+		CellDataMap::Iterator E = cells.find(c);
+		REQUIRE(E);
+		CHECK(E->key == c);
+		CHECK(E->value.coords == c);
+		CHECK(E->value.cell.source_id == c.x);
+	}
+	CHECK_FALSE(cells.has(Vector2i(1, 0)));
+	CHECK_FALSE(cells.find(Vector2i(5000, 5000)));
+
+	// Iteration visits every cell once.
+	uint32_t visited = 0;
+	for (const KeyValue<Vector2i, CellData> &kv : cells) {
+		CHECK(kv.key == kv.value.coords);
+		visited++;
+	}
+	CHECK(visited == cells.size());
+
+	// Inserting existing coords replaces the cell.
+	CellData replacement;
+	replacement.coords = Vector2i(0, 0);
+	replacement.cell.source_id = 42;
+	cells.insert(Vector2i(0, 0), replacement);
+	CHECK(cells.size() == std::size(coords));
+	CHECK(cells.find(Vector2i(0, 0))->value.cell.source_id == 42);
+
+	CHECK(cells.erase(Vector2i(-1, -1)));
+	CHECK_FALSE(cells.erase(Vector2i(-1, -1)));
+	CHECK_FALSE(cells.has(Vector2i(-1, -1)));
+	CHECK(cells.size() == std::size(coords) - 1);
+
+	for (const Vector2i &c : coords) {
+		cells.erase(c);
+	}
+	CHECK(cells.is_empty());
+	CHECK(cells.begin() == cells.end());
+
+	// Filling a whole chunk out of order, then emptying half of it.
+	for (int i = 0; i < CellDataMap::CHUNK_CELLS_COUNT; i++) {
+		const int scrambled = (i * 37) % CellDataMap::CHUNK_CELLS_COUNT;
+		CellData cell_data;
+		cell_data.coords = Vector2i(scrambled % CellDataMap::CHUNK_SIZE, scrambled / CellDataMap::CHUNK_SIZE);
+		CHECK(cells.insert(cell_data.coords, cell_data)->key == cell_data.coords);
+	}
+	CHECK(cells.size() == CellDataMap::CHUNK_CELLS_COUNT);
+	for (int i = 0; i < CellDataMap::CHUNK_CELLS_COUNT; i += 2) {
+		CHECK(cells.erase(Vector2i(i % CellDataMap::CHUNK_SIZE, i / CellDataMap::CHUNK_SIZE)));
+	}
+	CHECK(cells.size() == CellDataMap::CHUNK_CELLS_COUNT / 2);
+	for (int i = 0; i < CellDataMap::CHUNK_CELLS_COUNT; i++) {
+		const Vector2i c(i % CellDataMap::CHUNK_SIZE, i / CellDataMap::CHUNK_SIZE);
+		CellDataMap::Iterator E = cells.find(c);
+		CHECK(bool(E) == (i % 2 == 1));
+		if (E) {
+			CHECK(E->value.coords == c);
+		}
+	}
+	visited = 0;
+	for (const KeyValue<Vector2i, CellData> &kv : cells) {
+		CHECK(kv.key == kv.value.coords);
+		visited++;
+	}
+	CHECK(visited == cells.size());
+
+	cells.insert(Vector2i(2, 2), CellData());
+	cells.clear();
+	CHECK(cells.is_empty());
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Serialized cells are sorted by coords") {
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_tile_set(create_tile_set_with_collision());
+
+	// Painted out of order and across chunks.
+	const Vector2i coords[] = { Vector2i(20, 3), Vector2i(-1, 5), Vector2i(3, -20), Vector2i(3, 2), Vector2i(-40, 0), Vector2i(3, 1) };
+	for (const Vector2i &c : coords) {
+		layer->set_cell(c, 0, Vector2i());
+	}
+
+	const Vector<uint8_t> data = layer->get_tile_map_data_as_array();
+	REQUIRE(data.size() == 2 + int(std::size(coords)) * 12);
+	Vector<Vector2i> saved_coords;
+	for (int index = 2; index < data.size(); index += 12) {
+		saved_coords.push_back(Vector2i((int16_t)decode_uint16(&data[index]), (int16_t)decode_uint16(&data[index + 2])));
+	}
+	Vector<Vector2i> sorted_coords = saved_coords;
+	sorted_coords.sort();
+	CHECK(saved_coords == sorted_coords);
+	for (const Vector2i &c : coords) {
+		CHECK(saved_coords.has(c));
+	}
+
+	// Reloading and saving again gives the same data.
+	TileMapLayer *reloaded_layer = memnew(TileMapLayer);
+	reloaded_layer->set_tile_set(layer->get_tile_set());
+	reloaded_layer->set_tile_map_data_from_array(data);
+	CHECK(reloaded_layer->get_tile_map_data_as_array() == data);
+
+	memdelete(reloaded_layer);
+	memdelete(layer);
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Physics quadrant update budget") {
+	TileMapLayer *layer = memnew(TileMapLayer);
+	CHECK(layer->get_physics_quadrant_update_budget() == 0);
+
+	ERR_PRINT_OFF;
+	layer->set_physics_quadrant_update_budget(-1);
+	ERR_PRINT_ON;
+	CHECK(layer->get_physics_quadrant_update_budget() == 0);
+
+	layer->set_tile_set(create_tile_set_with_collision());
+	layer->set_physics_quadrant_size(4);
+	layer->set_physics_quadrant_update_budget(1);
+	SceneTree::get_singleton()->get_root()->add_child(layer);
+
+	// Paint 16 quadrants, they are rebuilt over the next frames.
+	for (int x = 0; x < 16; x++) {
+		for (int y = 0; y < 16; y++) {
+			layer->set_cell(Vector2i(x, y), 0, Vector2i());
+		}
+	}
+	SceneTree::get_singleton()->process(0);
+	CHECK(TestTileMapLayerInternalsAccessor::get_body_rids(layer).size() == 1);
+
+	for (int i = 0; i < 20; i++) {
+		SceneTree::get_singleton()->process(0);
+	}
+	CHECK(layer->get_used_cells().size() == 256);
+
+	// Each quadrant gets a single body.
+	LocalVector<RID> bodies = TestTileMapLayerInternalsAccessor::get_body_rids(layer);
+	CHECK(bodies.size() == 16);
+	HashSet<Vector2i> body_quadrants;
+	RID changed_body;
+	for (const RID &body : bodies) {
+		CHECK(layer->has_body_rid(body));
+		const Vector2i quadrant_coords = layer->get_coords_for_body_rid(body);
+		body_quadrants.insert(quadrant_coords);
+		if (quadrant_coords == Vector2i()) {
+			changed_body = body;
+		}
+	}
+	CHECK(body_quadrants.size() == 16);
+	for (int x = 0; x < 4; x++) {
+		for (int y = 0; y < 4; y++) {
+			CHECK(body_quadrants.has(Vector2i(x, y)));
+		}
+	}
+
+	// Later updates only replace the bodies of changed quadrants.
+	layer->erase_cell(Vector2i(1, 1));
+	for (int i = 0; i < 5; i++) {
+		SceneTree::get_singleton()->process(0);
+	}
+	CHECK(TestTileMapLayerInternalsAccessor::get_body_rids(layer).size() == 16);
+	CHECK_FALSE(layer->has_body_rid(changed_body));
+	for (const RID &body : bodies) {
+		if (body != changed_body) {
+			CHECK(layer->has_body_rid(body));
+		}
+	}
+
+	// Erasing cells while quadrants are still pending must be safe.
+	layer->set_physics_quadrant_update_budget(2);
+	for (int x = 0; x < 16; x++) {
+		layer->set_cell(Vector2i(x, 20), 0, Vector2i());
+		layer->erase_cell(Vector2i(x, 0));
+	}
+	SceneTree::get_singleton()->process(0);
+	layer->clear();
+	for (int i = 0; i < 20; i++) {
+		SceneTree::get_singleton()->process(0);
+	}
+	CHECK(layer->get_used_cells().is_empty());
+	CHECK(TestTileMapLayerInternalsAccessor::get_body_rids(layer).is_empty());
+
+	memdelete(layer);
+}
+
+TEST_CASE("[SceneTree][TileMapLayer][Benchmark] Paint 1M cells" * doctest::skip()) {
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_tile_set(create_tile_set_with_collision());
+	SceneTree::get_singleton()->get_root()->add_child(layer);
+
+	const int size = 1000;
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int x = 0; x < size; x++) {
+		for (int y = 0; y < size; y++) {
+			layer->set_cell(Vector2i(x, y), 0, Vector2i());
+		}
+	}
+	uint64_t painted = OS::get_singleton()->get_ticks_usec();
+	layer->update_internals();
+	uint64_t updated = OS::get_singleton()->get_ticks_usec();
+
+	print_line(vformat("Painted %d cells in %.3f ms, updated quadrants in %.3f ms.", size * size, (painted - start) / 1000.0, (updated - painted) / 1000.0));
+	CHECK(layer->get_used_cells().size() == size * size);
+
+	memdelete(layer);
+}
+
+} // namespace TestTileMapLayer
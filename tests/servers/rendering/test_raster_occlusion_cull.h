@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+static bool is_box_occluded(const RendererSceneOcclusionCull::HZBuffer *p_buffer, const AABB &p_aabb, const Transform3D &p_cam_transform, const Projection &p_cam_projection) {
+	const Vector3 end = p_aabb.get_end();
+	const real_t bounds[6] = { p_aabb.position.x, p_aabb.position.y, p_aabb.position.z, end.x, end.y, end.z };
+	uint64_t occlusion_timeout = 0;
+	return p_buffer->is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near(), p_cam_projection.is_orthogonal(), occlusion_timeout);
+}
+
+TEST_CASE("[RasterOcclusionCull] Occluders hide boxes behind them") {
+	RasterOcclusionCull *occlusion_cull = memnew(RasterOcclusionCull);
+
+	// 4x4 quad facing the camera, 5 units in front of it.
+	PackedVector3Array vertices = { Vector3(-2, -2, -5), Vector3(2, -2, -5), Vector3(2, 2, -5), Vector3(-2, 2, -5) };
+	PackedInt32Array indices = { 0, 1, 2, 0, 2, 3 };
+	RID occluder = occlusion_cull->occluder_allocate();
+	occlusion_cull->occluder_initialize(occluder);
+	occlusion_cull->occluder_set_mesh(occluder, vertices, indices);
+
+	const RID scenario = RID::from_uint64(1);
+	const RID instance = RID::from_uint64(2);
+	const RID buffer = RID::from_uint64(3);
+
+	occlusion_cull->add_scenario(scenario);
+	occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(), true);
+	occlusion_cull->add_buffer(buffer);
+	occlusion_cull->buffer_set_scenario(buffer, scenario);
+	occlusion_cull->buffer_set_size(buffer, Vector2i(64, 64));
+
+	const Transform3D cam_transform;
+	Projection projection;
+	AABB beside_box;
+
+	SUBCASE("Perspective camera") {
+		projection.set_perspective(75.0, 1.0, 0.05, 100.0);
+		beside_box = AABB(Vector3(11.5, -0.5, -20.5), Vector3(1, 1, 1));
+	}
+
+	SUBCASE("Orthogonal camera") {
+		projection.set_orthogonal(10.0, 1.0, 0.05, 100.0);
+		beside_box = AABB(Vector3(3, -0.5, -20.5), Vector3(1, 1, 1));
+	}
+
+	const AABB behind_box(Vector3(-0.5, -0.5, -20.5), Vector3(1, 1, 1));
+	const AABB front_box(Vector3(-0.5, -0.5, -3.5), Vector3(1, 1, 1));
+
+	occlusion_cull->buffer_update(buffer, cam_transform, projection, projection.is_orthogonal());
+	const RendererSceneOcclusionCull::HZBuffer *hz_buffer = occlusion_cull->buffer_get_ptr(buffer);
+	REQUIRE(hz_buffer != nullptr);
+
+	CHECK_MESSAGE(is_box_occluded(hz_buffer, behind_box, cam_transform, projection), "A box behind the occluder should be occluded.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(hz_buffer, front_box, cam_transform, projection), "A box in front of the occluder should not be occluded.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(hz_buffer, beside_box, cam_transform, projection), "A box next to the occluder should not be occluded.");
+
+	// Moving the occluder away makes the box behind it visible again.
+	occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(50, 0, 0)), true);
+	occlusion_cull->buffer_update(buffer, cam_transform, projection, projection.is_orthogonal());
+	CHECK_FALSE(is_box_occluded(hz_buffer, behind_box, cam_transform, projection));
+
+	// Occluders crossing the near plane are clipped instead of discarded.
+	// This slanted quad starts behind the camera and crosses the view axis 5 units in front of it.
+	vertices = { Vector3(-4, -2, 5), Vector3(4, -2, 5), Vector3(4, 4, -25), Vector3(-4, 4, -25) };
+	occlusion_cull->occluder_set_mesh(occluder, vertices, indices);
+	occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(), true);
+	occlusion_cull->buffer_update(buffer, cam_transform, projection, projection.is_orthogonal());
+	CHECK(is_box_occluded(hz_buffer, behind_box, cam_transform, projection));
+
+	occlusion_cull->remove_buffer(buffer);
+	occlusion_cull->remove_scenario(scenario);
+	occlusion_cull->free_occluder(occluder);
+	memdelete(occlusion_cull);
+}
+
+} // namespace TestRasterOcclusionCull
@@ -0,0 +1,95 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/rendering/rendering_method.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+TEST_CASE("[SceneTree][RendererSceneCull] Frustum test results of instances moved while skipped are not reused") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RenderingMethod *scene = RSG::scene;
+
+	RID scenario = rs->scenario_create();
+	RID viewport = rs->viewport_create();
+	RID camera = rs->camera_create();
+	rs->camera_set_perspective(camera, 75.0, 0.05, 100.0);
+	rs->camera_set_cull_mask(camera, 1);
+
+	RID mesh = rs->mesh_create();
+	RID instance = rs->instance_create2(mesh, scenario);
+	rs->instance_set_custom_aabb(instance, AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+	rs->instance_set_layer_mask(instance, 1);
+	rs->instance_set_transform(instance, Transform3D(Basis(), Vector3(1000, 0, 0)));
+
+	// Culls the scenario with the camera, and latches the frustum test counts of that cull.
+	Ref<XRInterface> xr_interface;
+	auto cull = [&]() {
+		scene->update();
+		scene->render_camera(Ref<RenderSceneBuffers>(), camera, scenario, viewport, Size2(64, 64), 0, 0.0, RID(), xr_interface);
+		scene->update();
+	};
+
+	// Outside of the frustum, the result is cached while nothing changes.
+	cull();
+	CHECK(scene->get_instances_frustum_tested_in_frame() == 1);
+	CHECK(scene->get_instances_frustum_reused_in_frame() == 0);
+	cull();
+	CHECK(scene->get_instances_frustum_tested_in_frame() == 0);
+	CHECK(scene->get_instances_frustum_reused_in_frame() == 1);
+
+	// Moved in front of the camera while its layer is masked out, so the frustum test is skipped.
+	rs->instance_set_layer_mask(instance, 2);
+	rs->instance_set_transform(instance, Transform3D(Basis(), Vector3(0, 0, -10)));
+	cull();
+	CHECK(scene->get_instances_frustum_tested_in_frame() == 0);
+	CHECK(scene->get_instances_frustum_reused_in_frame() == 0);
+
+	// Once unmasked, the stale result must not be reused.
+	rs->instance_set_layer_mask(instance, 1);
+	cull();
+	CHECK(scene->get_instances_frustum_tested_in_frame() == 1);
+	CHECK(scene->get_instances_frustum_reused_in_frame() == 0);
+	cull();
+	CHECK(scene->get_instances_frustum_tested_in_frame() == 0);
+	CHECK(scene->get_instances_frustum_reused_in_frame() == 1);
+
+	rs->free_rid(instance);
+	rs->free_rid(mesh);
+	rs->free_rid(camera);
+	rs->free_rid(viewport);
+	rs->free_rid(scenario);
+}
+
+} // namespace TestRendererSceneCull
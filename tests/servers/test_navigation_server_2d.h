@@ -33,6 +33,7 @@
 #include "modules/navigation_2d/nav_utils_2d.h"
 #include "servers/navigation_2d/navigation_server_2d.h"
 
+#include "core/config/project_settings.h"
 #include "scene/2d/polygon_2d.h"
 
 #include "tests/test_macros.h"
@@ -741,6 +742,57 @@ TEST_SUITE("[Navigation2D]") {
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer2D] Server should reuse cached paths until the map changes") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+		Ref<NavigationPolygon> navigation_polygon;
+		navigation_polygon.instantiate();
+		Ref<NavigationMeshSourceGeometryData2D> source_geometry;
+		source_geometry.instantiate();
+
+		navigation_polygon->add_outline(PackedVector2Array({ Vector2(-1000.0, -1000.0), Vector2(1000.0, -1000.0), Vector2(1000.0, 1000.0), Vector2(-1000.0, 1000.0) }));
+		source_geometry->add_obstruction_outline(PackedVector2Array({ Vector2(-200.0, -200.0), Vector2(200.0, -200.0), Vector2(200.0, 200.0), Vector2(-200.0, 200.0) }));
+		navigation_server->bake_from_source_geometry_data(navigation_polygon, source_geometry, Callable());
+		CHECK_NE(navigation_polygon->get_polygon_count(), 0);
+
+		ProjectSettings::get_singleton()->set_setting("navigation/2d/path_cache_size", 16);
+		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/2d/path_cache_size", 0);
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_polygon(region, navigation_polygon);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector<Vector2> path = navigation_server->map_get_path(map, Vector2(-500, -500), Vector2(500, 500), true);
+		CHECK_NE(path.size(), 0);
+		CHECK_EQ(navigation_server->map_get_path(map, Vector2(-500, -500), Vector2(500, 500), true), path);
+		navigation_server->physics_process(0.0); // Give server some cycles to update the counters.
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer2D::INFO_PATH_CACHE_HIT_COUNT), 1);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer2D::INFO_PATH_CACHE_MISS_COUNT), 1);
+
+		SUBCASE("Queries with different filters should not share cached paths") {
+			CHECK_EQ(navigation_server->map_get_path(map, Vector2(-500, -500), Vector2(500, 500), true, 2).size(), 0);
+			navigation_server->physics_process(0.0); // Give server some cycles to update the counters.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer2D::INFO_PATH_CACHE_HIT_COUNT), 1);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer2D::INFO_PATH_CACHE_MISS_COUNT), 2);
+		}
+
+		SUBCASE("Map changes should invalidate cached paths") {
+			navigation_server->region_set_enter_cost(region, 5.0);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->map_get_path(map, Vector2(-500, -500), Vector2(500, 500), true), path);
+			navigation_server->physics_process(0.0); // Give server some cycles to update the counters.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer2D::INFO_PATH_CACHE_HIT_COUNT), 1);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer2D::INFO_PATH_CACHE_MISS_COUNT), 2);
+		}
+
+		navigation_server->free_rid(region);
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	TEST_CASE("[NavigationServer2D] Server should simplify path properly") {
 		real_t simplify_epsilon = 0.2;
 		Vector<Vector2> source_path;
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/config/project_settings.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_3d/navigation_server_3d.h"
@@ -44,10 +45,12 @@ public:
 	void function1(Variant arg0) {
 		function1_calls++;
 		function1_latest_arg0 = arg0;
+		function1_args.push_back(arg0);
 	}
 
 	unsigned function1_calls{ 0 };
 	Variant function1_latest_arg0;
+	Array function1_args;
 };
 
 TEST_SUITE("[Navigation3D]") {
@@ -798,11 +801,196 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(query_result->get_path().size(), 0);
 		}
 
+		SUBCASE("Batched queries without callback should match single queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			const Vector3 positions[3][2] = {
+				{ Vector3(0, 0, 0), Vector3(10, 0, 10) },
+				{ Vector3(10, 0, 10), Vector3(0, 0, 0) },
+				{ Vector3(0, 0, 0), Vector3(10, 0, 10) },
+			};
+			for (int i = 0; i < 3; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters;
+				query_parameters.instantiate();
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(positions[i][0]);
+				query_parameters->set_target_position(positions[i][1]);
+				if (i == 2) {
+					query_parameters->set_navigation_layers(2);
+				}
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				batch_parameters.push_back(query_parameters);
+				batch_results.push_back(query_result);
+			}
+			navigation_server->query_paths(batch_parameters, batch_results);
+
+			for (int i = 0; i < 2; i++) {
+				Ref<NavigationPathQueryResult3D> single_result;
+				single_result.instantiate();
+				navigation_server->query_path(batch_parameters[i], single_result);
+				Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				CHECK_NE(batch_result->get_path().size(), 0);
+				CHECK_EQ(batch_result->get_path(), single_result->get_path());
+				CHECK_EQ(batch_result->get_path_rids(), single_result->get_path_rids());
+			}
+			Ref<NavigationPathQueryResult3D> filtered_result = batch_results[2];
+			CHECK_EQ(filtered_result->get_path().size(), 0);
+		}
+
+		SUBCASE("Batched queries with callback should be delivered on a later sync in submission order") {
+			CallableMock callback_mock;
+			TypedArray<NavigationPathQueryResult3D> all_results;
+			for (int i = 0; i < 3; i++) {
+				TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+				TypedArray<NavigationPathQueryResult3D> batch_results;
+				for (int j = 0; j < 4; j++) {
+					Ref<NavigationPathQueryParameters3D> query_parameters;
+					query_parameters.instantiate();
+					query_parameters->set_map(map);
+					query_parameters->set_start_position(Vector3(j, 0, 0));
+					query_parameters->set_target_position(Vector3(10, 0, 10 - i));
+					Ref<NavigationPathQueryResult3D> query_result;
+					query_result.instantiate();
+					batch_parameters.push_back(query_parameters);
+					batch_results.push_back(query_result);
+					all_results.push_back(query_result);
+				}
+				navigation_server->query_paths(batch_parameters, batch_results, callable_mp(&callback_mock, &CallableMock::function1).bind(i));
+			}
+			CHECK_EQ(callback_mock.function1_calls, 0);
+
+			for (int i = 0; i < 1000 && callback_mock.function1_calls < 3; i++) {
+				OS::get_singleton()->delay_usec(1000);
+				navigation_server->physics_process(0.0);
+			}
+			CHECK_EQ(callback_mock.function1_calls, 3);
+			CHECK_EQ(callback_mock.function1_args, Array({ 0, 1, 2 }));
+			for (int i = 0; i < all_results.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result = all_results[i];
+				CHECK_NE(query_result->get_path().size(), 0);
+			}
+		}
+
 		navigation_server->free_rid(region);
 		navigation_server->free_rid(map);
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should find paths with hierarchical path search") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A 16x16 grid of unit quads with a wall at x = 8 that leaves a gap at the far end,
+		// and a separate island that can't be reached from the grid.
+		const int grid_size = 16;
+		const int wall_x = 8;
+		const int wall_length = 14;
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= grid_size; z++) {
+			for (int x = 0; x <= grid_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		const int island_vertex = vertices.size();
+		vertices.push_back(Vector3(20, 0, 0));
+		vertices.push_back(Vector3(21, 0, 0));
+		vertices.push_back(Vector3(21, 0, 1));
+		vertices.push_back(Vector3(20, 0, 1));
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < grid_size; z++) {
+			for (int x = 0; x < grid_size; x++) {
+				if (x == wall_x && z < wall_length) {
+					continue;
+				}
+				const int vertex = z * (grid_size + 1) + x;
+				navigation_mesh->add_polygon({ vertex, vertex + 1, vertex + grid_size + 2, vertex + grid_size + 1 });
+			}
+		}
+		navigation_mesh->add_polygon({ island_vertex, island_vertex + 1, island_vertex + 2, island_vertex + 3 });
+
+		RID flat_map = navigation_server->map_create();
+
+		// Small clusters, so the coarse route spans many clusters.
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/use_hierarchical_path_search", true);
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/hierarchical_path_search_cluster_size", 4);
+		RID hierarchical_map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/use_hierarchical_path_search", false);
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/hierarchical_path_search_cluster_size", 128);
+
+		RID flat_region = navigation_server->region_create();
+		RID hierarchical_region = navigation_server->region_create();
+		for (const RID &map : { flat_map, hierarchical_map }) {
+			navigation_server->map_set_active(map, true);
+			navigation_server->map_set_use_async_iterations(map, false);
+		}
+		navigation_server->region_set_use_async_iterations(flat_region, false);
+		navigation_server->region_set_use_async_iterations(hierarchical_region, false);
+		navigation_server->region_set_map(flat_region, flat_map);
+		navigation_server->region_set_map(hierarchical_region, hierarchical_map);
+		navigation_server->region_set_navigation_mesh(flat_region, navigation_mesh);
+		navigation_server->region_set_navigation_mesh(hierarchical_region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		auto get_path_length = [](const Vector<Vector3> &p_path) {
+			real_t length = 0.0;
+			for (int i = 1; i < p_path.size(); i++) {
+				length += p_path[i - 1].distance_to(p_path[i]);
+			}
+			return length;
+		};
+
+		SUBCASE("Hierarchical path goes around the wall like the flat path") {
+			const Vector3 from = Vector3(0.5, 0, 0.5);
+			const Vector3 to = Vector3(grid_size - 0.5, 0, 0.5);
+			const Vector<Vector3> flat_path = navigation_server->map_get_path(flat_map, from, to, true);
+			const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(hierarchical_map, from, to, true);
+			REQUIRE(flat_path.size() > 2);
+			REQUIRE(hierarchical_path.size() > 2);
+			CHECK(hierarchical_path[0].is_equal_approx(from));
+			CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(to));
+
+			// Every segment stays on the navigation mesh, so it goes through the gap instead of the wall.
+			for (int i = 1; i < hierarchical_path.size(); i++) {
+				for (int step = 0; step <= 10; step++) {
+					const Vector3 point = hierarchical_path[i - 1].lerp(hierarchical_path[i], step / 10.0);
+					CHECK(navigation_server->map_get_closest_point(hierarchical_map, point).distance_to(point) < 0.01);
+				}
+			}
+			bool passes_gap = false;
+			for (const Vector3 &point : hierarchical_path) {
+				passes_gap = passes_gap || point.z >= wall_length - 0.01;
+			}
+			CHECK(passes_gap);
+
+			// The coarse route narrows the search, the path found in it should not be much longer.
+			const real_t flat_length = get_path_length(flat_path);
+			const real_t hierarchical_length = get_path_length(hierarchical_path);
+			CHECK(hierarchical_length >= flat_length * 0.99);
+			CHECK(hierarchical_length <= flat_length * 1.2);
+		}
+
+		SUBCASE("Unreachable target falls back to the full polygon search") {
+			// No coarse route reaches the island, so the path ends at the closest reachable point, as on the flat map.
+			const Vector3 from = Vector3(0.5, 0, 0.5);
+			const Vector3 to = Vector3(20.5, 0, 0.5);
+			const Vector<Vector3> flat_path = navigation_server->map_get_path(flat_map, from, to, true);
+			const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(hierarchical_map, from, to, true);
+			REQUIRE(flat_path.size() > 0);
+			REQUIRE(hierarchical_path.size() == flat_path.size());
+			for (int i = 0; i < flat_path.size(); i++) {
+				CHECK(hierarchical_path[i].is_equal_approx(flat_path[i]));
+			}
+			CHECK(hierarchical_path[hierarchical_path.size() - 1].x <= grid_size + 0.01);
+		}
+
+		navigation_server->free_rid(flat_region);
+		navigation_server->free_rid(hierarchical_region);
+		navigation_server->free_rid(flat_map);
+		navigation_server->free_rid(hierarchical_map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {